@@ -1,11 +1,24 @@
 #include <iostream>
 
 #include "utils/GraphUtils.h"
+#include "utils/FlowWriter.h"
+#include "cli/BatchRunner.h"
+#include "cli/SolverServer.h"
 #include "algorithms/MaximumFlowAlgorithms.h"
 #include "algorithms/MinimumCostFlowAlgorithms.h"
 
 int main(int argc, char **argv) {
 
+    // serve the queries on a Unix domain socket (see cli::SolverServer)
+    if (cli::SolverServer::IsServerMode(argc, argv)) {
+        return cli::SolverServer::Run(argc, argv);
+    }
+
+    // options given: solve the files without asking anything (see cli::BatchRunner)
+    if (cli::BatchRunner::IsBatchMode(argc, argv)) {
+        return cli::BatchRunner::Run(argc, argv);
+    }
+
     std::string filename {};
 
     // Check if file name was given else ask for it
@@ -23,9 +36,10 @@ int main(int argc, char **argv) {
         auto graph = utils::GraphUtils::CreateGraphFromJSON(filename);
 
         std::cout << "Select the network flow problem:" << std::endl;
-        std::cout << "1. Maximum flow (EdmondsKarp)" << std::endl;
+        std::cout << "1. Maximum flow (Choose algorithm...)" << std::endl;
         std::cout << "2. Minimum cost flow (Choose algorithm...)" << std::endl;
-        std::cout << "3. Exit" << std::endl;
+        std::cout << "3. All-pairs minimum cut (Gomory-Hu tree)" << std::endl;
+        std::cout << "4. Exit" << std::endl;
         std::cout << "Enter your choice: ";
         int choice {};
         std::cin >> choice;
@@ -34,15 +48,51 @@ int main(int argc, char **argv) {
         // for simplicity, we assume that the source is the first node and the sink is the last node
         int source {};
         int sink { graph->getNumNodes() - 1 };
+        if (choice != 4 && sink <= source) {
+            throw std::invalid_argument("The source and the sink must be two different nodes of the graph");
+        }
         std::shared_ptr<dto::FlowResult> result;
 
         switch (choice) {
             case 1: {
-                result = algorithms::MaximumFlowAlgorithms::EdmondsKarp(graph, source, sink);
+                std::cout << "Select the algorithm:" << std::endl;
+                std::cout << "1. Edmonds-Karp" << std::endl;
+                std::cout << "2. Parallel push-relabel" << std::endl;
+                std::cout << "3. Exit" << std::endl;
+                std::cout << "Enter your choice: ";
+                std::cin >> choice;
+                std::cout << std::endl;
+
+                switch (choice) {
+                    case 1 : {
+                        std::cout << "Edmonds-Karp selected!" << std::endl;
+                        result = algorithms::MaximumFlowAlgorithms::EdmondsKarp(graph, source, sink);
+                        break;
+                    }
+                    case 2 : {
+                        std::cout << "Parallel push-relabel selected!" << std::endl;
+                        result = algorithms::MaximumFlowAlgorithms::ParallelPushRelabel(graph, source, sink);
+                        break;
+                    }
+                    case 3: {
+                        return EXIT_SUCCESS;
+                    }
+                    default: {
+                        throw std::invalid_argument("Invalid choice!");
+                    }
+                }
                 std::cout << "Graph with flow: " << std::endl;
-                auto opt_graph = utils::GraphUtils::GetOptimalGraph(result->getGraph(), utils::GraphUtils::GetResidualGraph(graph));
-                std::cout << opt_graph->toString() << std::endl;
+                utils::FlowWriter::Write(std::cout, graph, *result->getEdgeFlows(), utils::FlowWriter::Format::PrettyJson);
+                std::cout << std::endl;
                 std::cout << "Maximum flow: " << result->getFlow() << std::endl;
+
+                auto min_cut = result->getMinCut();
+                std::cout << "Minimum cut capacity: " << min_cut->getCapacity() << std::endl;
+                std::cout << "Minimum cut edges:";
+                for (const auto& e : *min_cut->getCutEdges()) {
+                    std::cout << " (" << e.getSource() << ", " << e.getSink() << ")";
+                }
+                std::cout << std::endl;
                 break;
             }
             case 2: {
@@ -79,11 +129,24 @@ int main(int argc, char **argv) {
                     }
                 }
                 std::cout << "Graph with flow: " << std::endl;
-                std::cout << result->getGraph()->toString() << std::endl;
+                utils::FlowWriter::Write(std::cout, graph, *result->getEdgeFlows(), utils::FlowWriter::Format::PrettyJson);
+                std::cout << std::endl;
                 std::cout << "Minimum cost flow: " << result->getFlow() << std::endl;
                 break;
             }
             case 3: {
+                std::cout << "Gomory-Hu tree selected!" << std::endl;
+                auto tree = algorithms::MaximumFlowAlgorithms::GomoryHu(graph);
+
+                // each node except the root is linked to its parent by an edge weighted with their minimum cut
+                std::cout << "Gomory-Hu tree edges:" << std::endl;
+                for (int node = 1; node < tree->getNumNodes(); node++) {
+                    std::cout << "(" << node << ", " << tree->getParents()->at(node) << "): " << tree->getWeights()->at(node) << std::endl;
+                }
+                std::cout << "Minimum cut between source and sink: " << tree->getMinCut(source, sink) << std::endl;
+                break;
+            }
+            case 4: {
                 break;
             }
             default: {
@@ -93,6 +156,9 @@ int main(int argc, char **argv) {
     } catch (std::invalid_argument& e) {
         std::cout << "ERROR: " << e.what() << std::endl;
         return EXIT_FAILURE;
+    } catch (std::overflow_error& e) {
+        std::cout << "ERROR: " << e.what() << std::endl;
+        return EXIT_FAILURE;
     }
 
     return EXIT_SUCCESS;
@@ -2,15 +2,22 @@
 
 #include "consts/Consts.h"
 #include "utils/GraphUtils.h"
+#include "utils/ArithmeticUtils.h"
+#include "utils/ThreadPool.h"
+#include "utils/Stats.h"
 
 #include <set>
 #include <queue>
 #include <vector>
 #include <memory>
-#include <limits>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+#include <functional>
 
 namespace algorithms {
     std::shared_ptr<dto::BfsResult> GraphBaseAlgorithms::BFS(const std::shared_ptr<data_structures::Graph>& graph, int source, int sink) {
+        NETWORK_FLOWS_STATS_ADD(BfsCalls, 1);
         int num_nodes { graph->getNumNodes() };
         auto parent = std::make_shared<std::vector<int>>(num_nodes);
 
@@ -26,6 +33,8 @@ namespace algorithms {
             int current_node { q.front() };
             q.pop();
 
+            NETWORK_FLOWS_STATS_ADD(NodesScanned, 1);
+            NETWORK_FLOWS_STATS_ADD(ArcsRelaxed, graph->getNodeAdjList(current_node)->size());
             for (auto e : *graph->getNodeAdjList(current_node)) {
 
                 if (!visited.at(e.getSink())) {
@@ -45,43 +54,274 @@ namespace algorithms {
         return std::make_shared<dto::BfsResult>(false, parent);
     }
 
-     std::shared_ptr<dto::BellmanFordResult> GraphBaseAlgorithms::BellmanFord(const std::shared_ptr<data_structures::Graph>& graph, int source) {
-        int num_nodes { graph->getNumNodes() };
+    bool GraphBaseAlgorithms::BidirectionalBFS(const std::shared_ptr<data_structures::ResidualNetwork>& network, int source, int sink,
+        const std::shared_ptr<data_structures::BfsWorkspace>& workspace) {
 
-        auto dist = std::make_shared<std::vector<int>>(num_nodes);
-        auto parent = std::make_shared<std::vector<int>>(num_nodes);
+        NETWORK_FLOWS_STATS_ADD(BfsCalls, 1);
+        workspace->reset();
+        // a path without arcs carries no flow
+        if (source == sink) {
+            return false;
+        }
 
-        // Initialize the distance array to infinity and the parent array to -1
-        for (int i = 0; i < num_nodes; i++) {
-            dist->at(i) = std::numeric_limits<int>::max();
-            parent->at(i) = -1;
+        auto& forward_frontier = workspace->getForwardFrontier();
+        auto& backward_frontier = workspace->getBackwardFrontier();
+        auto& next_frontier = workspace->getNextFrontier();
+
+        workspace->visitForward(source, -1);
+        forward_frontier.push_back(source);
+        workspace->visitBackward(sink, -1);
+        backward_frontier.push_back(sink);
+
+        // every level is expanded completely: the first node reached by both sides
+        // then lies on a shortest path
+        while (!forward_frontier.empty() && !backward_frontier.empty()) {
+            next_frontier.clear();
+
+            if (forward_frontier.size() <= backward_frontier.size()) {
+                for (int node : forward_frontier) {
+                    NETWORK_FLOWS_STATS_ADD(NodesScanned, 1);
+                    NETWORK_FLOWS_STATS_ADD(ArcsRelaxed, network->getLastArc(node) - network->getFirstArc(node));
+                    for (int arc = network->getFirstArc(node); arc < network->getLastArc(node); arc++) {
+                        int head { network->getHead(arc) };
+                        if (workspace->isForwardVisited(head) || network->getResidualCapacity(arc) <= 0) {
+                            continue;
+                        }
+
+                        workspace->visitForward(head, arc);
+                        if (workspace->isBackwardVisited(head)) {
+                            workspace->setMeetingNode(head);
+                            return true;
+                        }
+                        next_frontier.push_back(head);
+                    }
+                }
+                forward_frontier.swap(next_frontier);
+            } else {
+                for (int node : backward_frontier) {
+                    NETWORK_FLOWS_STATS_ADD(NodesScanned, 1);
+                    NETWORK_FLOWS_STATS_ADD(ArcsRelaxed, network->getLastArc(node) - network->getFirstArc(node));
+                    for (int arc = network->getFirstArc(node); arc < network->getLastArc(node); arc++) {
+                        // the twin goes from the head to the node
+                        int head { network->getHead(arc) };
+                        int twin { network->getTwin(arc) };
+                        if (workspace->isBackwardVisited(head) || network->getResidualCapacity(twin) <= 0) {
+                            continue;
+                        }
+
+                        workspace->visitBackward(head, twin);
+                        if (workspace->isForwardVisited(head)) {
+                            workspace->setMeetingNode(head);
+                            return true;
+                        }
+                        next_frontier.push_back(head);
+                    }
+                }
+                backward_frontier.swap(next_frontier);
+            }
+        }
+
+        // If we reach here, then there is no path from source to sink
+        return false;
+    }
+
+    void GraphBaseAlgorithms::DirectionOptimizingBFS(const std::shared_ptr<data_structures::ResidualNetwork>& network, int root, bool reverse,
+        std::vector<std::atomic<int>>& label) {
+
+        int num_nodes { network->getNumNodes() };
+        int num_words { (num_nodes + 63) / 64 };
+        auto pool = utils::ThreadPool::GetInstance();
+        int num_threads { pool->getNumThreads() };
+
+        // frontier as a list of nodes (top-down steps) and as a bitmap (bottom-up steps)
+        std::vector<int> frontier { root };
+        std::vector<std::atomic<std::uint64_t>> frontier_bits(num_words);
+        std::vector<std::atomic<std::uint64_t>> next_bits(num_words);
+        bool bits_valid { false };
+
+        std::vector<std::vector<int>> next_frontier(num_threads);
+        std::vector<long long> thread_arcs(num_threads, 0);
+
+        // arcs leaving the frontier and arcs leaving the nodes not labeled yet
+        long long frontier_arcs { network->getLastArc(root) - network->getFirstArc(root) };
+        pool->parallelFor(num_nodes, consts::parallel_grain * 64, [&](int begin, int end, int thread) {
+            for (int node = begin; node < end; node++) {
+                if (label[node].load(std::memory_order_relaxed) == -1) {
+                    thread_arcs[thread] += network->getLastArc(node) - network->getFirstArc(node);
+                }
+            }
+        });
+        long long unexplored_arcs {};
+        for (auto& arcs : thread_arcs) {
+            unexplored_arcs += arcs;
+            arcs = 0;
         }
+
+        int level { label[root].load(std::memory_order_relaxed) };
+        bool bottom_up { false };
+
+        NETWORK_FLOWS_STATS_ADD(BfsCalls, 1);
+        while (!frontier.empty()) {
+            // the bottom-up steps stop at the first arc reaching the frontier, so the arcs are an upper bound
+            NETWORK_FLOWS_STATS_ADD(NodesScanned, frontier.size());
+            NETWORK_FLOWS_STATS_ADD(ArcsRelaxed, frontier_arcs);
+
+            if (!bottom_up && frontier_arcs > unexplored_arcs / consts::bfs_alpha) {
+                bottom_up = true;
+            } else if (bottom_up && static_cast<long long>(frontier.size()) * consts::bfs_beta < num_nodes) {
+                bottom_up = false;
+            }
+
+            if (!bottom_up) {
+                pool->parallelFor(static_cast<int>(frontier.size()), consts::parallel_grain, [&](int begin, int end, int thread) {
+                    auto& local_frontier = next_frontier[thread];
+
+                    for (int i = begin; i < end; i++) {
+                        int node { frontier[i] };
+                        for (int arc = network->getFirstArc(node); arc < network->getLastArc(node); arc++) {
+                            int head { network->getHead(arc) };
+                            int residual_arc { reverse ? network->getTwin(arc) : arc };
+                            int unlabeled { -1 };
+
+                            if (network->getResidualCapacity(residual_arc) > 0 &&
+                                label[head].compare_exchange_strong(unlabeled, level + 1, std::memory_order_relaxed)) {
+                                local_frontier.push_back(head);
+                                thread_arcs[thread] += network->getLastArc(head) - network->getFirstArc(head);
+                            }
+                        }
+                    }
+                });
+                bits_valid = false;
+            } else {
+                if (!bits_valid) {
+                    pool->parallelFor(num_words, consts::parallel_grain * 64, [&](int begin, int end, int) {
+                        for (int word = begin; word < end; word++) {
+                            frontier_bits[word].store(0, std::memory_order_relaxed);
+                        }
+                    });
+                    pool->parallelFor(static_cast<int>(frontier.size()), consts::parallel_grain * 64, [&](int begin, int end, int) {
+                        for (int i = begin; i < end; i++) {
+                            frontier_bits[frontier[i] / 64].fetch_or(std::uint64_t { 1 } << (frontier[i] % 64), std::memory_order_relaxed);
+                        }
+                    });
+                }
+
+                // every thread labels the nodes of whole words, so the next bitmap is written without conflicts
+                pool->parallelFor(num_words, consts::parallel_grain, [&](int begin, int end, int thread) {
+                    auto& local_frontier = next_frontier[thread];
+
+                    for (int word = begin; word < end; word++) {
+                        std::uint64_t bits {};
+
+                        for (int node = word * 64; node < std::min(num_nodes, word * 64 + 64); node++) {
+                            if (label[node].load(std::memory_order_relaxed) != -1) {
+                                continue;
+                            }
+
+                            for (int arc = network->getFirstArc(node); arc < network->getLastArc(node); arc++) {
+                                int head { network->getHead(arc) };
+                                int residual_arc { reverse ? arc : network->getTwin(arc) };
+                                bool in_frontier { ((frontier_bits[head / 64].load(std::memory_order_relaxed) >> (head % 64)) & 1) != 0 };
+
+                                if (in_frontier && network->getResidualCapacity(residual_arc) > 0) {
+                                    label[node].store(level + 1, std::memory_order_relaxed);
+                                    bits |= std::uint64_t { 1 } << (node % 64);
+                                    local_frontier.push_back(node);
+                                    thread_arcs[thread] += network->getLastArc(node) - network->getFirstArc(node);
+                                    break;
+                                }
+                            }
+                        }
+
+                        next_bits[word].store(bits, std::memory_order_relaxed);
+                    }
+                });
+                frontier_bits.swap(next_bits);
+                bits_valid = true;
+            }
+
+            frontier.clear();
+            for (auto& local_frontier : next_frontier) {
+                frontier.insert(frontier.end(), local_frontier.begin(), local_frontier.end());
+                local_frontier.clear();
+            }
+
+            frontier_arcs = 0;
+            for (auto& arcs : thread_arcs) {
+                frontier_arcs += arcs;
+                arcs = 0;
+            }
+            unexplored_arcs -= frontier_arcs;
+            level++;
+        }
+    }
+
+    std::shared_ptr<dto::BellmanFordResult> GraphBaseAlgorithms::BellmanFord(const std::shared_ptr<data_structures::Graph>& graph, int source) {
+        // the sweeps run on the structure of arrays representation of the graph
+        auto network = std::make_shared<data_structures::ResidualNetwork>(graph);
+        return GraphBaseAlgorithms::BellmanFord(network, source);
+    }
+
+    std::shared_ptr<dto::BellmanFordResult> GraphBaseAlgorithms::BellmanFord(const std::shared_ptr<data_structures::ResidualNetwork>& network, int source) {
+        NETWORK_FLOWS_STATS_ADD(BellmanFordCalls, 1);
+        int num_nodes { network->getNumNodes() };
+
+        auto dist = std::make_shared<std::vector<types::accumulator_t>>(num_nodes, consts::infinite_distance);
+        auto parent = std::make_shared<std::vector<int>>(num_nodes, -1);
         dist->at(source) = 0;
 
         // Relax all edges |V| - 1 times (because the shortest path from source to any other node can have at most |V| - 1 edges)
         for (int i = 0; i < num_nodes - 1; i++) {
+            bool relaxed { false };
+
             for (int node = 0; node < num_nodes; node++) {
-                for (auto e : *graph->getNodeAdjList(node)) {
-                    int sink { e.getSink() };
-                    int cost { e.getCost() };
+                types::accumulator_t node_dist { (*dist)[node] };
+                if (node_dist == consts::infinite_distance) {
+                    continue;
+                }
+
+                NETWORK_FLOWS_STATS_ADD(NodesScanned, 1);
+                NETWORK_FLOWS_STATS_ADD(ArcsRelaxed, network->getLastArc(node) - network->getFirstArc(node));
+
+                // the arcs of the node are contiguous in every array
+                for (int arc = network->getFirstArc(node); arc < network->getLastArc(node); arc++) {
+                    if (network->getResidualCapacity(arc) <= 0) {
+                        continue;
+                    }
+
+                    int sink { network->getHead(arc) };
+                    auto new_dist { utils::ArithmeticUtils::CheckedAdd<types::accumulator_t>(node_dist, network->getCost(arc)) };
 
                     // Update dist[v] if dist[u] + weight < dist[v]
-                    if (dist->at(node) != std::numeric_limits<int>::max() && dist->at(node) + cost < dist->at(sink)) {
-                        dist->at(sink) = dist->at(node) + cost;
-                        parent->at(sink) = node;
+                    if (new_dist < (*dist)[sink]) {
+                        (*dist)[sink] = new_dist;
+                        (*parent)[sink] = node;
+                        relaxed = true;
                     }
                 }
             }
+
+            // no distance changed, the next sweeps would not change them either
+            if (!relaxed) {
+                break;
+            }
         }
 
         // Check for negative-cost cycles
         for (int node = 0; node < num_nodes; node++) {
-            for (auto e : *graph->getNodeAdjList(node)) {
-                int sink { e.getSink() };
-                int cost { e.getCost() };
+            if (dist->at(node) == consts::infinite_distance) {
+                continue;
+            }
+
+            for (int arc = network->getFirstArc(node); arc < network->getLastArc(node); arc++) {
+                if (network->getResidualCapacity(arc) <= 0) {
+                    continue;
+                }
+
+                int sink { network->getHead(arc) };
 
                 // Found a negative-weight cycle, get the cycle and return it
-                if (dist->at(node) != std::numeric_limits<int>::max() && dist->at(node) + cost < dist->at(sink)) {
+                if (utils::ArithmeticUtils::CheckedAdd<types::accumulator_t>(dist->at(node), network->getCost(arc)) < dist->at(sink)) {
 
                     // Result in case a negative-weight cycle was found
                     // It contains the negative-weight cycle
@@ -96,16 +336,17 @@ namespace algorithms {
     }
 
     std::shared_ptr<dto::DijkstraResult> GraphBaseAlgorithms::Dijkstra(const std::shared_ptr<data_structures::Graph>& graph, int source) {
+        NETWORK_FLOWS_STATS_ADD(DijkstraCalls, 1);
         int num_nodes { graph->getNumNodes() };
 
-        auto dist = std::make_shared<std::vector<int>>(num_nodes);
+        auto dist = std::make_shared<std::vector<types::accumulator_t>>(num_nodes);
         auto parent = std::make_shared<std::vector<int>>(num_nodes);
         std::vector<int> q {};    // q contains all the nodes that have not been visited yet
         std::set<int> visited {}; // visited contains all the nodes that have been visited
 
         // Initialize the distance array to infinity and the parent array to -1
         for (int i = 0; i < num_nodes; i++) {
-            dist->at(i) = std::numeric_limits<int>::max();
+            dist->at(i) = consts::infinite_distance;
             parent->at(i) = -1;
             q.push_back(i);
         }
@@ -117,7 +358,7 @@ namespace algorithms {
         while (!q.empty()) {
 
             // Find the node with the minimum distance
-            int min_dist { std::numeric_limits<int>::max() };
+            types::accumulator_t min_dist { consts::infinite_distance };
             int current_node { -1 };  // node
             int current_index { -1 }; // node index
             for (unsigned i=0; i < q.size(); i++) {
@@ -129,6 +370,11 @@ namespace algorithms {
                 }
             }
 
+            // the remaining nodes are not reachable from the source
+            if (current_node == -1) {
+                break;
+            }
+
             // remove the node from the queue
             q.erase(q.begin() + current_index);
 
@@ -136,13 +382,15 @@ namespace algorithms {
             visited.insert(current_node);
 
             // Relax all edges going out of the current node
+            NETWORK_FLOWS_STATS_ADD(NodesScanned, 1);
+            NETWORK_FLOWS_STATS_ADD(ArcsRelaxed, graph->getNodeAdjList(current_node)->size());
             for (auto e : *graph->getNodeAdjList(current_node)) {
                 int sink { e.getSink() };
-                int cost { e.getCost() };
+                auto new_dist { utils::ArithmeticUtils::CheckedAdd<types::accumulator_t>(dist->at(current_node), e.getCost()) };
 
                 // Update dist[v] if dist[u] + weight < dist[v]
-                if (dist->at(current_node) != std::numeric_limits<int>::max() && dist->at(current_node) + cost < dist->at(sink)) {
-                    dist->at(sink) = dist->at(current_node) + cost;
+                if (new_dist < dist->at(sink)) {
+                    dist->at(sink) = new_dist;
                     parent->at(sink) = current_node;
                 }
             }
@@ -150,4 +398,110 @@ namespace algorithms {
 
         return std::make_shared<dto::DijkstraResult>(dist, parent);
     }
-}
+
+    std::shared_ptr<dto::DijkstraResult> GraphBaseAlgorithms::Dijkstra(const std::shared_ptr<data_structures::ResidualNetwork>& network, int source) {
+        NETWORK_FLOWS_STATS_ADD(DijkstraCalls, 1);
+        int num_nodes { network->getNumNodes() };
+
+        auto dist = std::make_shared<std::vector<types::accumulator_t>>(num_nodes, consts::infinite_distance);
+        auto parent = std::make_shared<std::vector<int>>(num_nodes, -1);
+        auto parent_arc = std::make_shared<std::vector<int>>(num_nodes, -1);
+        std::vector<bool> visited(num_nodes, false);
+
+        // min-priority queue of (distance, node), a node can be inserted more than once (lazy deletion)
+        using queue_entry = std::pair<types::accumulator_t, int>;
+        std::priority_queue<queue_entry, std::vector<queue_entry>, std::greater<>> q {};
+
+        // Set source distance and parent
+        dist->at(source) = 0;
+        parent->at(source) = consts::source_parent;
+        q.emplace(0, source);
+
+        while (!q.empty()) {
+            int current_node { q.top().second };
+            q.pop();
+
+            // skip the outdated entries
+            if (visited[current_node]) {
+                continue;
+            }
+            visited[current_node] = true;
+
+            types::accumulator_t current_dist { (*dist)[current_node] };
+
+            // Relax all the arcs with positive residual capacity going out of the current node
+            NETWORK_FLOWS_STATS_ADD(NodesScanned, 1);
+            NETWORK_FLOWS_STATS_ADD(ArcsRelaxed, network->getLastArc(current_node) - network->getFirstArc(current_node));
+            for (int arc = network->getFirstArc(current_node); arc < network->getLastArc(current_node); arc++) {
+                if (network->getResidualCapacity(arc) <= 0) {
+                    continue;
+                }
+
+                int sink { network->getHead(arc) };
+                auto new_dist { utils::ArithmeticUtils::CheckedAdd(current_dist, network->getReducedCost(arc)) };
+
+                // Update dist[v] if dist[u] + weight < dist[v]
+                if (new_dist < (*dist)[sink]) {
+                    (*dist)[sink] = new_dist;
+                    (*parent)[sink] = current_node;
+                    (*parent_arc)[sink] = arc;
+                    q.emplace(new_dist, sink);
+                }
+            }
+        }
+
+        return std::make_shared<dto::DijkstraResult>(dist, parent, parent_arc);
+    }
+
+    bool GraphBaseAlgorithms::Dijkstra(const std::shared_ptr<data_structures::ResidualNetwork>& network, int source, int target,
+        const std::shared_ptr<data_structures::DijkstraWorkspace>& workspace) {
+
+        NETWORK_FLOWS_STATS_ADD(DijkstraCalls, 1);
+        workspace->reset();
+
+        // min-heap of (distance, node), a node can be inserted more than once (lazy deletion)
+        auto& q = workspace->getQueue();
+        workspace->reach(source, 0, -1);
+        q.emplace_back(0, source);
+
+        while (!q.empty()) {
+            std::pop_heap(q.begin(), q.end(), std::greater<>());
+            int current_node { q.back().second };
+            q.pop_back();
+
+            // skip the outdated entries
+            if (workspace->isSettled(current_node)) {
+                continue;
+            }
+            workspace->settle(current_node);
+
+            // the distances of the other nodes are not needed
+            if (current_node == target) {
+                return true;
+            }
+
+            types::accumulator_t current_dist { workspace->getDistance(current_node) };
+
+            // Relax all the arcs with positive residual capacity going out of the current node
+            NETWORK_FLOWS_STATS_ADD(NodesScanned, 1);
+            NETWORK_FLOWS_STATS_ADD(ArcsRelaxed, network->getLastArc(current_node) - network->getFirstArc(current_node));
+            for (int arc = network->getFirstArc(current_node); arc < network->getLastArc(current_node); arc++) {
+                if (network->getResidualCapacity(arc) <= 0) {
+                    continue;
+                }
+
+                int sink { network->getHead(arc) };
+                auto new_dist { utils::ArithmeticUtils::CheckedAdd(current_dist, network->getReducedCost(arc)) };
+
+                // Update dist[v] if dist[u] + weight < dist[v]
+                if (!workspace->isReached(sink) || new_dist < workspace->getDistance(sink)) {
+                    workspace->reach(sink, new_dist, arc);
+                    q.emplace_back(new_dist, sink);
+                    std::push_heap(q.begin(), q.end(), std::greater<>());
+                }
+            }
+        }
+
+        return false;
+    }
+}
\ No newline at end of file
@@ -3,13 +3,22 @@
 
 #include "dto/bfsResult/BfsResult.h"
 #include "data_structures/graph/Graph.h"
+#include "data_structures/graph/ResidualNetwork.h"
+#include "data_structures/workspace/BfsWorkspace.h"
+#include "data_structures/workspace/DijkstraWorkspace.h"
 #include "dto/dijkstra/DijkstraResult.h"
 #include "dto/bellmanFord/BellmanFordResult.h"
 
+#include <atomic>
+#include <vector>
+#include <memory>
+
 namespace algorithms {
     /**
      * Class containing the following graph base algorithms:
      * - BFS (Breadth-first search) -> used to find the path from source to sink.
+     * - Bidirectional BFS -> used to find the augmenting paths of Edmonds-Karp.
+     * - Direction-optimizing BFS -> used to compute the distances on the residual network (e.g. global relabel).
      * - Bellman-Ford -> used to get the shortest path from source to any other node,
      *                   also it is used to detect negative cycles.
      */
@@ -37,6 +46,57 @@ namespace algorithms {
          */
         static std::shared_ptr<dto::BfsResult> BFS(const std::shared_ptr<data_structures::Graph>& graph, int source, int sink);
 
+        /**
+         * Bidirectional BFS applied to a residual network.
+         * A forward search from the source (on the arcs with positive residual capacity) and a backward
+         * search from the sink (on the twins of the arcs with positive residual capacity) are expanded
+         * one level at a time, always the side with the smaller frontier, until they meet:
+         * on wide and shallow networks they visit a small fraction of the nodes visited by BFS().
+         * The path found is a shortest path (in number of arcs), as the one found by BFS().
+         * The visited nodes and the parent arcs are stored in the workspace, which is reset at the start
+         * (see BfsWorkspace.h), use GraphUtils::RetrieveArcPath() to get the path.
+         *
+         * V: number of nodes
+         * E: number of edges
+         * Time complexity: O(V + E)
+         *
+         * @param network   the residual network
+         * @param source    the source node
+         * @param sink      the sink node
+         * @param workspace the workspace of the search
+         *
+         * @return true if there is a path from source to sink, false otherwise (also if the source is the sink)
+         */
+        static bool BidirectionalBFS(const std::shared_ptr<data_structures::ResidualNetwork>& network, int source, int sink,
+            const std::shared_ptr<data_structures::BfsWorkspace>& workspace);
+
+        /**
+         * Parallel direction-optimizing BFS (Beamer, Asanovic and Patterson) applied to a residual network.
+         * A top-down step expands the arcs of the frontier, a bottom-up step checks, for every node
+         * not labeled yet, if one of its neighbours is in the frontier (a bitmap) and stops at the first one.
+         * The search switches to bottom-up steps when the arcs of the frontier are more than
+         * the arcs of the unlabeled nodes / consts::bfs_alpha, and back to top-down steps when the frontier
+         * has less than V / consts::bfs_beta nodes: on networks with large middle frontiers (e.g. power-law
+         * degrees) most of the arc checks of a top-down step are wasted on already labeled nodes.
+         * The nodes are labeled with label(root) + their distance from the root, the nodes already labeled
+         * (label != -1) are not visited again, so they block the search.
+         *
+         * (see: https://doi.org/10.1109/SC.2012.50)
+         *
+         * V: number of nodes
+         * E: number of edges
+         * P: number of threads (see utils::ThreadPool)
+         * Time complexity: O((V + E) / P) for the top-down steps, O(V * D) for the bottom-up steps in the worst case
+         *
+         * @param network the residual network
+         * @param root    the root of the search, already labeled
+         * @param reverse false to follow the arcs with positive residual capacity (distance from the root),
+         *                true to follow them backwards (distance to the root)
+         * @param label   the label of each node (-1 if not labeled yet)
+         */
+        static void DirectionOptimizingBFS(const std::shared_ptr<data_structures::ResidualNetwork>& network, int root, bool reverse,
+            std::vector<std::atomic<int>>& label);
+
         /**
          * Bellman-Ford algorithm used to detect negative cycles.
          * Bellman-Ford algorithm is an algorithm that computes shortest paths from a single source vertex.
@@ -49,6 +109,8 @@ namespace algorithms {
          * E: number of edges
          * Time complexity: O(V * E)
          * 
+         * The graph is converted to a ResidualNetwork, so edges with zero capacity are ignored.
+         *
          * @param graph  the graph to solve
          * @param source the source node
          * 
@@ -56,6 +118,22 @@ namespace algorithms {
          */
         static std::shared_ptr<dto::BellmanFordResult> BellmanFord(const std::shared_ptr<data_structures::Graph>& graph, int source);
 
+        /**
+         * Bellman-Ford algorithm applied to a residual network (see the function above).
+         * Only the arcs with positive residual capacity are relaxed, using their costs.
+         * The sweeps stop as soon as one of them does not change any distance.
+         *
+         * V: number of nodes
+         * E: number of edges
+         * Time complexity: O(V * E)
+         *
+         * @param network the residual network
+         * @param source  the source node
+         *
+         * @return the result of the algorithm (see BellmanFordResult.h)
+         */
+        static std::shared_ptr<dto::BellmanFordResult> BellmanFord(const std::shared_ptr<data_structures::ResidualNetwork>& network, int source);
+
         /**
          * Dijkstra algorithm.
          * Dijkstra's algorithm is an algorithm for finding the shortest paths between nodes in a graph.
@@ -74,6 +152,44 @@ namespace algorithms {
          * @return the result of the algorithm (see DijkstraResult.h)
          */
         static std::shared_ptr<dto::DijkstraResult> Dijkstra(const std::shared_ptr<data_structures::Graph>& graph, int source);
+
+        /**
+         * Dijkstra algorithm applied to a residual network.
+         * Only the arcs with positive residual capacity are relaxed, using their reduced costs
+         * (see ResidualNetwork::getReducedCost()), that must be non-negative.
+         * The result contains also the arc used to reach each node.
+         *
+         * V: number of nodes
+         * E: number of edges
+         * Time complexity: O((V + E) * log(V)) (binary heap)
+         *
+         * @param network the residual network
+         * @param source  the source node
+         *
+         * @return the result of the algorithm (see DijkstraResult.h)
+         */
+        static std::shared_ptr<dto::DijkstraResult> Dijkstra(const std::shared_ptr<data_structures::ResidualNetwork>& network, int source);
+
+        /**
+         * Dijkstra algorithm applied to a residual network (see the function above) that stops as soon as
+         * the target is settled. The distances, the parent arcs and the settled nodes are stored in the workspace,
+         * which is reset at the start (see DijkstraWorkspace.h): nothing is allocated or reset per node,
+         * so the cost of a search is proportional to the part of the network it explores.
+         * The nodes not settled have a distance not less than the distance of the target.
+         *
+         * V': number of nodes reached
+         * E': number of arcs leaving the settled nodes
+         * Time complexity: O((V' + E') * log(V'))
+         *
+         * @param network   the residual network
+         * @param source    the source node
+         * @param target    the target node
+         * @param workspace the workspace of the search
+         *
+         * @return true if the target was reached, false otherwise
+         */
+        static bool Dijkstra(const std::shared_ptr<data_structures::ResidualNetwork>& network, int source, int target,
+            const std::shared_ptr<data_structures::DijkstraWorkspace>& workspace);
     };
 }
 
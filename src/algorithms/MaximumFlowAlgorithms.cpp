@@ -2,41 +2,421 @@
 
 #include "utils/GraphUtils.h"
 #include "consts/Consts.h"
+#include "utils/ArithmeticUtils.h"
+#include "utils/ThreadPool.h"
+#include "utils/Stats.h"
 #include "GraphBaseAlgorithms.h"
+#include "ParallelShortestPathAlgorithms.h"
 
+#include <map>
 #include <memory>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
 
 namespace algorithms {
      std::shared_ptr<dto::FlowResult> MaximumFlowAlgorithms::EdmondsKarp(const std::shared_ptr<data_structures::Graph>& graph, int source, int sink) {
-        int max_flow {};
+        NETWORK_FLOWS_STATS_SCOPE(stats);
 
-        // the residual graph (if needed anti-parallel edges are removed using artificial nodes)
-        auto residual_graph = utils::GraphUtils::GetResidualGraph(graph);
+        // the residual network (an edge and its anti-parallel edge have their own pairs of arcs)
+        NETWORK_FLOWS_STATS_TIMER(residual_timer, ResidualNetwork);
+        auto network = std::make_shared<data_structures::ResidualNetwork>(graph);
+        NETWORK_FLOWS_STATS_STOP(residual_timer);
 
-        auto bfs_result = GraphBaseAlgorithms::BFS(residual_graph, source, sink);
+        return NETWORK_FLOWS_STATS_RESULT(stats, MaximumFlowAlgorithms::EdmondsKarp(graph, network, source, sink));
+    }
+
+    std::shared_ptr<dto::FlowResult> MaximumFlowAlgorithms::EdmondsKarp(const std::shared_ptr<data_structures::Graph>& graph,
+        const std::shared_ptr<data_structures::ResidualNetwork>& network, int source, int sink) {
+
+        NETWORK_FLOWS_STATS_SCOPE(stats);
+
+        // select the kernel specialised for the input graph
+        NETWORK_FLOWS_STATS_TIMER(max_flow_timer, MaxFlow);
+        types::accumulator_t max_flow { utils::GraphUtils::HasUnitCapacities(graph)
+            ? MaximumFlowAlgorithms::edmondsKarpKernel<types::UnitCapacityTraits>(network, source, sink)
+            : MaximumFlowAlgorithms::edmondsKarpKernel<types::GeneralCapacityTraits>(network, source, sink) };
+        NETWORK_FLOWS_STATS_STOP(max_flow_timer);
+
+        // Build the result with optimal graph, edge flows, max flow and min cut
+        return NETWORK_FLOWS_STATS_RESULT(stats, MaximumFlowAlgorithms::maximumFlowResult(graph, network, source, max_flow));
+    }
+
+    std::shared_ptr<dto::FlowResult> MaximumFlowAlgorithms::EdmondsKarp(const std::shared_ptr<data_structures::GraphSnapshot>& snapshot,
+        int source, int sink) {
+
+        NETWORK_FLOWS_STATS_SCOPE(stats);
+
+        // only the residual capacities are copied from the snapshot
+        NETWORK_FLOWS_STATS_TIMER(residual_timer, ResidualNetwork);
+        auto network = std::make_shared<data_structures::ResidualNetwork>(snapshot);
+        NETWORK_FLOWS_STATS_STOP(residual_timer);
+
+        NETWORK_FLOWS_STATS_TIMER(max_flow_timer, MaxFlow);
+        types::accumulator_t max_flow { snapshot->hasUnitCapacities()
+            ? MaximumFlowAlgorithms::edmondsKarpKernel<types::UnitCapacityTraits>(network, source, sink)
+            : MaximumFlowAlgorithms::edmondsKarpKernel<types::GeneralCapacityTraits>(network, source, sink) };
+        NETWORK_FLOWS_STATS_STOP(max_flow_timer);
+
+        return NETWORK_FLOWS_STATS_RESULT(stats, MaximumFlowAlgorithms::maximumFlowResult(snapshot, network, source, max_flow));
+    }
+
+    template <typename Traits>
+    types::accumulator_t MaximumFlowAlgorithms::edmondsKarpKernel(const std::shared_ptr<data_structures::ResidualNetwork>& network, int source, int sink) {
+        MaximumFlowAlgorithms::checkNodes(network, source, sink);
+        types::accumulator_t max_flow {};
+
+        // the search buffers are reused by every search
+        auto workspace = std::make_shared<data_structures::BfsWorkspace>(network->getNumNodes());
 
         // while there is a path from source to sink
-        while (bfs_result->isPathFound()) {
+        while (GraphBaseAlgorithms::BidirectionalBFS(network, source, sink, workspace)) {
+
+            NETWORK_FLOWS_STATS_ADD(Augmentations, 1);
 
-            auto parent = bfs_result->getParent();
-            
             // reconstruct the path from source to sink
-            auto path = utils::GraphUtils::RetrievePath(parent, consts::source_parent, sink);
+            auto path = utils::GraphUtils::RetrieveArcPath(network, workspace, source, sink);
+
+            if constexpr (Traits::unit_capacity) {
+                // every residual arc has capacity 0 or 1: the arcs of the path are saturated,
+                // no capacity has to be looked up
+                for (int arc : *path) {
+                    network->pushFlow(arc, 1);
+                }
+
+                // update the max flow
+                max_flow = utils::ArithmeticUtils::CheckedAdd<types::accumulator_t>(max_flow, 1);
+            } else {
+                // find the minimum residual capacity of the arcs in the path
+                auto path_flow = utils::GraphUtils::GetResidualCapacity(network, path);
+
+                // update the residual capacities
+                utils::GraphUtils::SendFlowInArcPath(network, path, path_flow);
+
+                // update the max flow
+                max_flow = utils::ArithmeticUtils::CheckedAdd<types::accumulator_t>(max_flow, path_flow);
+            }
+        }
+
+        return max_flow;
+    }
+
+    std::shared_ptr<dto::FlowResult> MaximumFlowAlgorithms::ParallelPushRelabel(const std::shared_ptr<data_structures::Graph>& graph, int source, int sink) {
+        NETWORK_FLOWS_STATS_SCOPE(stats);
+
+        // the residual network (an edge and its anti-parallel edge have their own pairs of arcs)
+        NETWORK_FLOWS_STATS_TIMER(residual_timer, ResidualNetwork);
+        auto network = std::make_shared<data_structures::ResidualNetwork>(graph);
+        NETWORK_FLOWS_STATS_STOP(residual_timer);
 
-            // find the minimum residual capacity of the edges in the path
-            auto path_flow = utils::GraphUtils::GetResidualCapacity(residual_graph, path);
+        return NETWORK_FLOWS_STATS_RESULT(stats, MaximumFlowAlgorithms::ParallelPushRelabel(graph, network, source, sink));
+    }
+
+    std::shared_ptr<dto::FlowResult> MaximumFlowAlgorithms::ParallelPushRelabel(const std::shared_ptr<data_structures::Graph>& graph,
+        const std::shared_ptr<data_structures::ResidualNetwork>& network, int source, int sink) {
+
+        NETWORK_FLOWS_STATS_SCOPE(stats);
+
+        NETWORK_FLOWS_STATS_TIMER(max_flow_timer, MaxFlow);
+        types::accumulator_t max_flow { MaximumFlowAlgorithms::pushRelabel(network, source, sink) };
+        NETWORK_FLOWS_STATS_STOP(max_flow_timer);
+
+        // Build the result with optimal graph, edge flows, max flow and min cut
+        return NETWORK_FLOWS_STATS_RESULT(stats, MaximumFlowAlgorithms::maximumFlowResult(graph, network, source, max_flow));
+    }
+
+    std::shared_ptr<dto::FlowResult> MaximumFlowAlgorithms::ParallelPushRelabel(const std::shared_ptr<data_structures::GraphSnapshot>& snapshot,
+        int source, int sink) {
+
+        NETWORK_FLOWS_STATS_SCOPE(stats);
+
+        // only the residual capacities are copied from the snapshot
+        NETWORK_FLOWS_STATS_TIMER(residual_timer, ResidualNetwork);
+        auto network = std::make_shared<data_structures::ResidualNetwork>(snapshot);
+        NETWORK_FLOWS_STATS_STOP(residual_timer);
+
+        NETWORK_FLOWS_STATS_TIMER(max_flow_timer, MaxFlow);
+        types::accumulator_t max_flow { MaximumFlowAlgorithms::pushRelabel(network, source, sink) };
+        NETWORK_FLOWS_STATS_STOP(max_flow_timer);
+
+        return NETWORK_FLOWS_STATS_RESULT(stats, MaximumFlowAlgorithms::maximumFlowResult(snapshot, network, source, max_flow));
+    }
+
+    template <typename Input>
+    std::shared_ptr<dto::FlowResult> MaximumFlowAlgorithms::maximumFlowResult(const std::shared_ptr<Input>& input,
+        const std::shared_ptr<data_structures::ResidualNetwork>& network, int source, types::accumulator_t max_flow) {
+
+        NETWORK_FLOWS_STATS_TIMER(min_cut_timer, MinCut);
+        auto min_cut = MaximumFlowAlgorithms::minimumCut(network, source);
+        NETWORK_FLOWS_STATS_STOP(min_cut_timer);
+
+        NETWORK_FLOWS_STATS_TIMER(solution_timer, Solution);
+        auto edge_flows = utils::GraphUtils::GetEdgeFlows(network, input);
+        return std::make_shared<dto::FlowResult>(utils::GraphUtils::GetOptimalGraph(input, *edge_flows), edge_flows, max_flow, min_cut);
+    }
+
+    std::shared_ptr<dto::GomoryHuTree> MaximumFlowAlgorithms::GomoryHu(const std::shared_ptr<data_structures::Graph>& graph) {
+        int num_nodes { graph->getNumNodes() };
+
+        // merge the anti-parallel edges: the capacity of the undirected edge {u, v} is c(u -> v) + c(v -> u)
+        std::map<std::pair<int, int>, types::capacity_t> capacities {};
+        for (int node = 0; node < num_nodes; node++) {
+            for (const auto& e : *graph->getNodeAdjList(node)) {
+                // a self-loop is never cut
+                if (e.getSource() == e.getSink()) {
+                    continue;
+                }
+
+                std::pair<int, int> key { std::minmax(e.getSource(), e.getSink()) };
+                capacities[key] = utils::ArithmeticUtils::CheckedAdd<types::capacity_t>(capacities[key], e.getCapacity());
+            }
+        }
+        auto undirected_graph = std::make_shared<data_structures::Graph>(num_nodes);
+        for (const auto& [nodes, capacity] : capacities) {
+            undirected_graph->addEdge(nodes.first, nodes.second, capacity, 0);
+        }
+
+        // the network is built once, every maximum flow starts from a copy of its capacities
+        auto network = std::make_shared<data_structures::ResidualNetwork>(undirected_graph);
+        network->makeUndirected();
+        const std::vector<types::capacity_t> undirected_capacities { network->getResidualCapacities() };
+        bool parallel { ParallelShortestPathAlgorithms::ShouldRunInParallel(network) };
+
+        auto parent = std::make_shared<std::vector<int>>(num_nodes, 0);
+        auto weight = std::make_shared<std::vector<types::accumulator_t>>(num_nodes, 0);
+        std::vector<std::atomic<int>> label(num_nodes);
+        if (num_nodes > 0) {
+            parent->at(0) = -1;
+        }
 
-            // update the residual capacities and the current flow
-            utils::GraphUtils::SendFlowInPathNegativeCosts(residual_graph, path, path_flow);
+        for (int node = 1; node < num_nodes; node++) {
+            int node_parent { parent->at(node) };
+            network->setResidualCapacities(undirected_capacities);
 
-            // update the max flow
-            max_flow += path_flow;
+            weight->at(node) = parallel
+                ? MaximumFlowAlgorithms::pushRelabel(network, node, node_parent)
+                : MaximumFlowAlgorithms::edmondsKarpKernel<types::GeneralCapacityTraits>(network, node, node_parent);
 
-            // find a new path from source to sink
-            bfs_result = GraphBaseAlgorithms::BFS(residual_graph, source, sink);
+            // the next nodes on the side of the node move below it
+            MaximumFlowAlgorithms::reachableNodes(network, node, label);
+            for (int other = node + 1; other < num_nodes; other++) {
+                if (parent->at(other) == node_parent && label[other].load(std::memory_order_relaxed) != -1) {
+                    parent->at(other) = node;
+                }
+            }
         }
 
-        // Build the result with residual graph and max flow
-        return std::make_shared<dto::FlowResult>(residual_graph, max_flow);
+        return std::make_shared<dto::GomoryHuTree>(parent, weight);
+    }
+
+    void MaximumFlowAlgorithms::checkNodes(const std::shared_ptr<data_structures::ResidualNetwork>& network, int source, int sink) {
+        int num_nodes { network->getNumNodes() };
+        if (source < 0 || sink < 0 || source >= num_nodes || sink >= num_nodes || source == sink) {
+            throw std::invalid_argument("The source and the sink must be two different nodes of the graph");
+        }
+    }
+
+    types::accumulator_t MaximumFlowAlgorithms::pushRelabel(const std::shared_ptr<data_structures::ResidualNetwork>& network, int source, int sink) {
+        MaximumFlowAlgorithms::checkNodes(network, source, sink);
+        auto pool = utils::ThreadPool::GetInstance();
+
+        int num_nodes { network->getNumNodes() };
+        std::vector<int> label(num_nodes, 0);                          // label of each node
+        std::vector<int> new_label(num_nodes, 0);                      // label of each node after the relabel
+        std::vector<std::uint8_t> to_relabel(num_nodes, 0);            // 1 if the node has excess left after the push
+        std::vector<std::atomic<types::accumulator_t>> excess(num_nodes); // excess of each node
+        std::vector<std::atomic<bool>> in_next(num_nodes);             // true if the node is in the next active nodes
+        std::vector<std::atomic<int>> bfs_label(num_nodes);            // global relabel workspace
+        for (int node = 0; node < num_nodes; node++) {
+            excess[node].store(0, std::memory_order_relaxed);
+            in_next[node].store(false, std::memory_order_relaxed);
+        }
+
+        // saturate the arcs leaving the source
+        std::vector<int> active {};
+        for (int arc = network->getFirstArc(source); arc < network->getLastArc(source); arc++) {
+            types::capacity_t residual_capacity { network->getResidualCapacity(arc) };
+            int node { network->getHead(arc) };
+            if (residual_capacity <= 0) {
+                continue;
+            }
+
+            network->pushFlow(arc, residual_capacity);
+            if (excess[node].fetch_add(residual_capacity) == 0 && node != sink) {
+                active.push_back(node);
+            }
+        }
+
+        MaximumFlowAlgorithms::globalRelabel(network, source, sink, bfs_label, label);
+
+        std::vector<std::vector<int>> next_active(pool->getNumThreads());
+        std::vector<long long> thread_relabels(pool->getNumThreads(), 0);
+        long long relabels {};
+
+        while (!active.empty()) {
+            // push the excess of the active nodes along the admissible arcs
+            pool->parallelFor(static_cast<int>(active.size()), consts::parallel_grain, [&](int begin, int end, int thread) {
+                auto& local_active = next_active[thread];
+
+                for (int i = begin; i < end; i++) {
+                    int node { active[i] };
+                    int node_label { label[node] };
+                    types::accumulator_t node_excess { excess[node].load() };
+                    types::accumulator_t pushed {};
+
+                    for (int arc = network->getFirstArc(node); arc < network->getLastArc(node) && pushed < node_excess; arc++) {
+                        int head { network->getHead(arc) };
+
+                        // the label is checked first: the residual capacity of a non admissible arc
+                        // can be written by the thread pushing on its twin
+                        if (label[head] + 1 != node_label || network->getResidualCapacity(arc) <= 0) {
+                            continue;
+                        }
+
+                        auto flow { static_cast<types::capacity_t>(std::min<types::accumulator_t>(node_excess - pushed, network->getResidualCapacity(arc))) };
+                        network->pushFlow(arc, flow);
+                        pushed += flow;
+                        NETWORK_FLOWS_STATS_ADD(Pushes, 1);
+
+                        excess[head].fetch_add(flow);
+                        if (head != source && head != sink && !in_next[head].exchange(true)) {
+                            local_active.push_back(head);
+                        }
+                    }
+
+                    excess[node].fetch_sub(pushed);
+                    to_relabel[node] = pushed < node_excess;
+                }
+            });
+
+            // relabel the nodes with excess left, using the labels of the previous pulse
+            pool->parallelFor(static_cast<int>(active.size()), consts::parallel_grain, [&](int begin, int end, int thread) {
+                for (int i = begin; i < end; i++) {
+                    int node { active[i] };
+                    if (!to_relabel[node]) {
+                        continue;
+                    }
+
+                    int min_label { 2 * num_nodes };
+                    for (int arc = network->getFirstArc(node); arc < network->getLastArc(node); arc++) {
+                        if (network->getResidualCapacity(arc) > 0) {
+                            min_label = std::min(min_label, label[network->getHead(arc)] + 1);
+                        }
+                    }
+                    new_label[node] = min_label;
+                    thread_relabels[thread]++;
+                    NETWORK_FLOWS_STATS_ADD(Relabels, 1);
+                }
+            });
+
+            for (int node : active) {
+                if (to_relabel[node]) {
+                    label[node] = new_label[node];
+                }
+            }
+
+            // the next active nodes are the ones that received flow and the ones with excess left
+            std::vector<int> current_active {};
+            current_active.swap(active);
+            for (auto& local_active : next_active) {
+                active.insert(active.end(), local_active.begin(), local_active.end());
+                local_active.clear();
+            }
+            for (int node : current_active) {
+                if (excess[node].load() > 0 && !in_next[node].exchange(true)) {
+                    active.push_back(node);
+                }
+            }
+            for (int node : active) {
+                in_next[node].store(false, std::memory_order_relaxed);
+            }
+
+            for (auto& local_relabels : thread_relabels) {
+                relabels += local_relabels;
+                local_relabels = 0;
+            }
+            if (relabels >= static_cast<long long>(consts::global_relabel_frequency) * num_nodes) {
+                MaximumFlowAlgorithms::globalRelabel(network, source, sink, bfs_label, label);
+                relabels = 0;
+            }
+        }
+
+        return excess[sink].load();
+    }
+
+    std::shared_ptr<dto::MinCut> MaximumFlowAlgorithms::minimumCut(const std::shared_ptr<data_structures::ResidualNetwork>& network, int source) {
+        int num_nodes { network->getNumNodes() };
+
+        // the source side contains the nodes reachable from the source
+        std::vector<std::atomic<int>> label(num_nodes);
+        MaximumFlowAlgorithms::reachableNodes(network, source, label);
+
+        std::vector<bool> reachable(num_nodes);
+        for (int node = 0; node < num_nodes; node++) {
+            reachable[node] = label[node].load(std::memory_order_relaxed) != -1;
+        }
+
+        auto source_side = std::make_shared<std::vector<bool>>(reachable);
+        auto cut_edges = std::make_shared<std::vector<data_structures::Edge>>();
+        types::accumulator_t capacity {};
+
+        // the forward arcs leaving the source side are saturated, their capacity is the residual capacity of the twin
+        for (int arc = 0; arc < network->getNumArcs(); arc++) {
+            int tail { network->getTail(arc) };
+            int head { network->getHead(arc) };
+            if (!network->isForward(arc) || !reachable[tail] || reachable[head]) {
+                continue;
+            }
+
+            // the edges with capacity 0 are not cut
+            types::capacity_t arc_capacity { network->getResidualCapacity(network->getTwin(arc)) };
+            if (arc_capacity == 0) {
+                continue;
+            }
+
+            capacity = utils::ArithmeticUtils::CheckedAdd<types::accumulator_t>(capacity, arc_capacity);
+            cut_edges->emplace_back(tail, head, arc_capacity, network->getCost(arc));
+        }
+
+        return std::make_shared<dto::MinCut>(source_side, cut_edges, capacity);
+    }
+
+    void MaximumFlowAlgorithms::reachableNodes(const std::shared_ptr<data_structures::ResidualNetwork>& network, int source,
+        std::vector<std::atomic<int>>& label) {
+
+        for (auto& node_label : label) {
+            node_label.store(-1, std::memory_order_relaxed);
+        }
+        label[source].store(0, std::memory_order_relaxed);
+        GraphBaseAlgorithms::DirectionOptimizingBFS(network, source, false, label);
+    }
+
+    void MaximumFlowAlgorithms::globalRelabel(const std::shared_ptr<data_structures::ResidualNetwork>& network, int source, int sink,
+        std::vector<std::atomic<int>>& bfs_label, std::vector<int>& label) {
+
+        NETWORK_FLOWS_STATS_ADD(GlobalRelabels, 1);
+        NETWORK_FLOWS_STATS_TIMER(global_relabel_timer, GlobalRelabel);
+        int num_nodes { network->getNumNodes() };
+        auto pool = utils::ThreadPool::GetInstance();
+
+        pool->parallelFor(num_nodes, consts::parallel_grain * 64, [&](int begin, int end, int) {
+            for (int node = begin; node < end; node++) {
+                bfs_label[node].store(-1, std::memory_order_relaxed);
+            }
+        });
+
+        // the source is labeled first so that the first search does not go through it
+        bfs_label[source].store(num_nodes, std::memory_order_relaxed);
+        bfs_label[sink].store(0, std::memory_order_relaxed);
+        GraphBaseAlgorithms::DirectionOptimizingBFS(network, sink, true, bfs_label);
+        GraphBaseAlgorithms::DirectionOptimizingBFS(network, source, true, bfs_label);
+
+        pool->parallelFor(num_nodes, consts::parallel_grain * 64, [&](int begin, int end, int) {
+            for (int node = begin; node < end; node++) {
+                int node_label { bfs_label[node].load(std::memory_order_relaxed) };
+                label[node] = node_label == -1 ? 2 * num_nodes : node_label;
+            }
+        });
     }
 }
\ No newline at end of file
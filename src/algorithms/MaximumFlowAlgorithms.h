@@ -2,12 +2,23 @@
 #define MINIMUM_COST_FLOWS_PROBLEM_MAXIMUMFLOWALGORITHMS_H
 
 #include "data_structures/graph/Graph.h"
+#include "data_structures/graph/ResidualNetwork.h"
+#include "data_structures/snapshot/GraphSnapshot.h"
 #include "dto/flowResult/FlowResult.h"
+#include "dto/minCut/MinCut.h"
+#include "dto/gomoryHuTree/GomoryHuTree.h"
+#include "types/GraphTraits.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
 
 namespace algorithms {
     /**
      * Class containing the following maximum flow algorithms:
      * - Edmonds-Karp
+     * - Parallel Push-Relabel
+     * - Gomory-Hu tree (all-pairs minimum cut)
      */
     class MaximumFlowAlgorithms {
         public:
@@ -23,13 +34,234 @@ namespace algorithms {
              * E: number of edges
              * Time complexity: O(V * E^2)
              *
+             * If every edge has capacity 1 a dedicated kernel is used (see types/GraphTraits.h).
+             *
              * @param graph  the graph to solve
              * @param source the source node
              * @param sink   the sink node
              * 
-             * @return the residual graph and the maximum flow
+             * @return the optimal graph, the maximum flow and the minimum cut
+             *
+             * @throws invalid_argument if the source and the sink are not two different nodes of the graph
              */
             static std::shared_ptr<dto::FlowResult> EdmondsKarp(const std::shared_ptr<data_structures::Graph>& graph, int source, int sink);
+
+            /**
+             * Edmonds-Karp algorithm on a residual network built by the caller (see EdmondsKarp()).
+             *
+             * @param graph   the graph to solve
+             * @param network the residual network of the graph, the flow is sent on it
+             * @param source  the source node
+             * @param sink    the sink node
+             *
+             * @return the optimal graph, the maximum flow and the minimum cut
+             *
+             * @throws invalid_argument if the source and the sink are not two different nodes of the graph
+             */
+            static std::shared_ptr<dto::FlowResult> EdmondsKarp(const std::shared_ptr<data_structures::Graph>& graph,
+                const std::shared_ptr<data_structures::ResidualNetwork>& network, int source, int sink);
+
+            /**
+             * Edmonds-Karp algorithm on the graph of a snapshot (see EdmondsKarp()): the residual network
+             * is built on the shared arrays of the snapshot, only its residual capacities are allocated.
+             *
+             * @param snapshot the snapshot of the graph to solve
+             * @param source   the source node
+             * @param sink     the sink node
+             *
+             * @return the optimal graph, the maximum flow and the minimum cut
+             *
+             * @throws invalid_argument if the source and the sink are not two different nodes of the graph
+             */
+            static std::shared_ptr<dto::FlowResult> EdmondsKarp(const std::shared_ptr<data_structures::GraphSnapshot>& snapshot, int source, int sink);
+
+            /**
+             * Synchronous parallel Push-Relabel algorithm (Baumstark, Blelloch and Shun).
+             * The source saturates its arcs, then at each pulse every active node (node with excess)
+             * pushes its excess along the admissible arcs (label(u) = label(v) + 1) in parallel,
+             * using the labels of the previous pulse: only one arc of each pair can be admissible,
+             * so the residual capacities are updated without locks and the excesses with atomic additions.
+             * After a barrier the nodes with excess left are relabeled in parallel, the new labels are
+             * written to a second array so that every node reads the labels of the previous pulse.
+             * A parallel global relabel (breadth-first search from the sink on the residual network)
+             * is done at the start and every consts::global_relabel_frequency * V relabels; the nodes that
+             * cannot reach the sink get label V + their distance from the source, so their excess is
+             * sent back to the source and the result is a flow.
+             * Return the optimal graph and the maximum flow, as EdmondsKarp().
+             *
+             * (see: https://arxiv.org/abs/1507.01926)
+             *
+             * V: number of nodes
+             * E: number of edges
+             * P: number of threads (see utils::ThreadPool)
+             * Time complexity: O(V^2 * E / P) (worst case)
+             *
+             * @param graph  the graph to solve
+             * @param source the source node
+             * @param sink   the sink node
+             *
+             * @return the optimal graph, the maximum flow and the minimum cut
+             *
+             * @throws invalid_argument if the source and the sink are not two different nodes of the graph
+             */
+            static std::shared_ptr<dto::FlowResult> ParallelPushRelabel(const std::shared_ptr<data_structures::Graph>& graph, int source, int sink);
+
+            /**
+             * Parallel Push-Relabel algorithm on a residual network built by the caller (see ParallelPushRelabel()).
+             *
+             * @param graph   the graph to solve
+             * @param network the residual network of the graph, the flow is sent on it
+             * @param source  the source node
+             * @param sink    the sink node
+             *
+             * @return the optimal graph, the maximum flow and the minimum cut
+             *
+             * @throws invalid_argument if the source and the sink are not two different nodes of the graph
+             */
+            static std::shared_ptr<dto::FlowResult> ParallelPushRelabel(const std::shared_ptr<data_structures::Graph>& graph,
+                const std::shared_ptr<data_structures::ResidualNetwork>& network, int source, int sink);
+
+            /**
+             * Parallel Push-Relabel algorithm on the graph of a snapshot (see ParallelPushRelabel() and
+             * EdmondsKarp(const std::shared_ptr<data_structures::GraphSnapshot>&, int, int)).
+             *
+             * @param snapshot the snapshot of the graph to solve
+             * @param source   the source node
+             * @param sink     the sink node
+             *
+             * @return the optimal graph, the maximum flow and the minimum cut
+             *
+             * @throws invalid_argument if the source and the sink are not two different nodes of the graph
+             */
+            static std::shared_ptr<dto::FlowResult> ParallelPushRelabel(const std::shared_ptr<data_structures::GraphSnapshot>& snapshot,
+                int source, int sink);
+
+            /**
+             * Gomory-Hu tree (Gusfield's algorithm) of the graph, where the capacity of an edge {u, v}
+             * is the sum of the capacities of u -> v and v -> u.
+             * Every node except the root 0 starts as a child of 0, then for each node in order a maximum flow
+             * from the node to its parent gives the weight of its tree edge, and the following nodes with
+             * the same parent that are on the side of the node in the minimum cut become its children.
+             * Unlike the original Gomory-Hu algorithm no graph is contracted: the undirected residual network
+             * is built once and each of the V - 1 maximum flows starts from a copy of its capacities.
+             * The maximum flows depend on the parents set by the previous ones, so they run one after
+             * the other: on large networks each of them is computed by the parallel Push-Relabel kernel
+             * (see ParallelPushRelabel()), otherwise by the Edmonds-Karp kernel.
+             * Then the minimum cut between any two nodes is the minimum weight on their tree path
+             * (see dto::GomoryHuTree::getMinCut()).
+             *
+             * (see: https://doi.org/10.1137/0219009)
+             *
+             * V: number of nodes
+             * E: number of edges
+             * F: time complexity of a maximum flow
+             * Time complexity: O(V * (F + E))
+             *
+             * @param graph the graph
+             *
+             * @return the Gomory-Hu tree
+             *
+             * @throws overflow_error if the capacity of an undirected edge overflows
+             */
+            static std::shared_ptr<dto::GomoryHuTree> GomoryHu(const std::shared_ptr<data_structures::Graph>& graph);
+
+        private:
+            /**
+             * Build the result of a maximum flow algorithm: optimal graph (see utils::GraphUtils::GetOptimalGraph()),
+             * edge flows, maximum flow and minimum cut.
+             *
+             * @tparam Input the input of the algorithm, a graph or a snapshot (see utils::GraphUtils::GetEdgeFlows())
+             *
+             * @param input    the graph or the snapshot of the graph
+             * @param network  the residual network of the maximum flow
+             * @param source   the source node
+             * @param max_flow the maximum flow
+             *
+             * @return the result
+             */
+            template <typename Input>
+            static std::shared_ptr<dto::FlowResult> maximumFlowResult(const std::shared_ptr<Input>& input,
+                const std::shared_ptr<data_structures::ResidualNetwork>& network, int source, types::accumulator_t max_flow);
+
+            /**
+             * Check that the source and the sink are two different nodes of the residual network.
+             *
+             * @param network the residual network
+             * @param source  the source node
+             * @param sink    the sink node
+             *
+             * @throws invalid_argument if the source and the sink are not two different nodes of the network
+             */
+            static void checkNodes(const std::shared_ptr<data_structures::ResidualNetwork>& network, int source, int sink);
+
+            /**
+             * Push-Relabel kernel of ParallelPushRelabel(), run on the residual network in place.
+             *
+             * @param network the residual network, the flow is sent on it
+             * @param source  the source node
+             * @param sink    the sink node
+             *
+             * @return the maximum flow
+             */
+            static types::accumulator_t pushRelabel(const std::shared_ptr<data_structures::ResidualNetwork>& network, int source, int sink);
+
+            /**
+             * Label the nodes reachable from the source on the residual network
+             * (see GraphBaseAlgorithms::DirectionOptimizingBFS()).
+             *
+             * @param network the residual network
+             * @param source  the source node
+             * @param label   output: the distance of each node from the source (-1 if not reachable)
+             */
+            static void reachableNodes(const std::shared_ptr<data_structures::ResidualNetwork>& network, int source,
+                std::vector<std::atomic<int>>& label);
+
+            /**
+             * Get the minimum cut from the residual network of a maximum flow: the source side contains
+             * the nodes reachable from the source (see GraphBaseAlgorithms::DirectionOptimizingBFS()),
+             * then a single pass over the arcs collects the forward arcs leaving the source side.
+             *
+             * V: number of nodes
+             * E: number of edges
+             * Time complexity: O(V + E)
+             *
+             * @param network the residual network of a maximum flow
+             * @param source  the source node
+             *
+             * @return the minimum cut
+             *
+             * @throws overflow_error if the capacity of the cut overflows
+             */
+            static std::shared_ptr<dto::MinCut> minimumCut(const std::shared_ptr<data_structures::ResidualNetwork>& network, int source);
+
+            /**
+             * Set the label of every node to its distance to the sink on the residual network
+             * (see GraphBaseAlgorithms::DirectionOptimizingBFS()).
+             * The nodes that cannot reach the sink get V + their distance to the source
+             * and the nodes that can reach neither get 2 * V.
+             *
+             * @param network   the residual network
+             * @param source    the source node
+             * @param sink      the sink node
+             * @param bfs_label workspace of V elements
+             * @param label     output: the label of each node
+             */
+            static void globalRelabel(const std::shared_ptr<data_structures::ResidualNetwork>& network, int source, int sink,
+                std::vector<std::atomic<int>>& bfs_label, std::vector<int>& label);
+
+            /**
+             * Edmonds-Karp kernel specialised at compile time on the graph traits, run on the residual network in place.
+             *
+             * @tparam Traits the traits of the graph (see types/GraphTraits.h)
+             *
+             * @param network the residual network, the flow is sent on it
+             * @param source  the source node
+             * @param sink    the sink node
+             *
+             * @return the maximum flow
+             */
+            template <typename Traits>
+            static types::accumulator_t edmondsKarpKernel(const std::shared_ptr<data_structures::ResidualNetwork>& network, int source, int sink);
     };
 }
 
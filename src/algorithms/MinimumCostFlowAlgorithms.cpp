@@ -1,10 +1,15 @@
 #include "MinimumCostFlowAlgorithms.h"
 
 #include "utils/GraphUtils.h"
+#include "utils/ArithmeticUtils.h"
+#include "utils/Stats.h"
+#include "consts/Consts.h"
 #include "GraphBaseAlgorithms.h"
 #include "MaximumFlowAlgorithms.h"
+#include "ParallelShortestPathAlgorithms.h"
 
 #include <map>
+#include <algorithm>
 #include <queue>
 #include <memory>
 #include <stdexcept>
@@ -13,66 +18,83 @@ namespace algorithms {
     std::shared_ptr<dto::FlowResult> MinimumCostFlowAlgorithms::CycleCancelling(const std::shared_ptr<data_structures::Graph>& graph,
         int source, int sink) {
 
-        // get the maximum flow using Edmonds-Karp (feasible flow)
-        auto edmonds_karps_result = MaximumFlowAlgorithms::EdmondsKarp(graph, source, sink);
-        
-        // get the residual graph
-        auto residual_graph = edmonds_karps_result->getGraph();
-        
-        // get the negative cycle using Bellman-Ford
-        auto bellman_ford_result = GraphBaseAlgorithms::BellmanFord(residual_graph, source);
-
-        // while there is a negative cycle in the residual graph augment the flow
-        while (bellman_ford_result->hasNegativeCycle()) {
-            auto negative_cycle = bellman_ford_result->getNegativeCycle();
-            int residual_capacity { utils::GraphUtils::GetResidualCapacity(residual_graph, negative_cycle) };
-
-            // update the residual capacities and the current flow (augment flow)
-            utils::GraphUtils::SendFlowInPathNegativeCosts(residual_graph, negative_cycle, residual_capacity);
-
-            bellman_ford_result = GraphBaseAlgorithms::BellmanFord(residual_graph, source);
+        NETWORK_FLOWS_STATS_SCOPE(stats);
+
+        // with zero costs every maximum flow is optimal
+        if (utils::GraphUtils::HasZeroCosts(graph)) {
+            return NETWORK_FLOWS_STATS_RESULT(stats, MinimumCostFlowAlgorithms::zeroCostFlow(graph, source, sink));
         }
 
-       // get the optimal graph
-        auto optimal_graph = utils::GraphUtils::GetOptimalGraph(residual_graph, graph);
+        // the residual network keeps the residual capacity of every arc
+        NETWORK_FLOWS_STATS_TIMER(residual_timer, ResidualNetwork);
+        auto network = std::make_shared<data_structures::ResidualNetwork>(graph);
+        NETWORK_FLOWS_STATS_STOP(residual_timer);
+
+        // send the maximum flow on the residual network using Edmonds-Karp (feasible flow)
+        MaximumFlowAlgorithms::EdmondsKarp(graph, network, source, sink);
+
+        // while there are negative cycles in the residual network cancel them
+        MinimumCostFlowAlgorithms::cancelNegativeCycles(network);
+
+        // get the optimal graph
+        NETWORK_FLOWS_STATS_TIMER(solution_timer, Solution);
+        auto edge_flows = utils::GraphUtils::GetEdgeFlows(network, graph);
+        auto optimal_graph = utils::GraphUtils::GetOptimalGraph(graph, *edge_flows);
 
         // get minimum cost
-        int minimum_cost { MinimumCostFlowAlgorithms::getMinimumCost(optimal_graph) };
+        types::accumulator_t minimum_cost { MinimumCostFlowAlgorithms::getMinimumCost(optimal_graph) };
 
-        return std::make_shared<dto::FlowResult>(optimal_graph, minimum_cost);
+        return NETWORK_FLOWS_STATS_RESULT(stats,
+            std::make_shared<dto::FlowResult>(optimal_graph, edge_flows, minimum_cost));
     }
 
     std::shared_ptr<dto::FlowResult> MinimumCostFlowAlgorithms::SuccessiveShortestPath(const std::shared_ptr<data_structures::Graph>& graph,
         int source, int sink) {
 
-        // get the residual graph
-        auto residual_graph = utils::GraphUtils::GetResidualGraph(graph);
+        NETWORK_FLOWS_STATS_SCOPE(stats);
 
-        // check if there is a negative cycle, if so Successive Shortest Path cannot be applied
-        auto bellman_ford_result = GraphBaseAlgorithms::BellmanFord(residual_graph, source);
-        if (bellman_ford_result->hasNegativeCycle()) {
+        // with zero costs every maximum flow is optimal
+        if (utils::GraphUtils::HasZeroCosts(graph)) {
+            return NETWORK_FLOWS_STATS_RESULT(stats, MinimumCostFlowAlgorithms::zeroCostFlow(graph, source, sink));
+        }
+
+        // the residual network keeps the residual capacity of every arc and the node potentials
+        // (the reduced costs are computed from them, see ResidualNetwork::getReducedCost())
+        NETWORK_FLOWS_STATS_TIMER(residual_timer, ResidualNetwork);
+        auto network = std::make_shared<data_structures::ResidualNetwork>(graph);
+        NETWORK_FLOWS_STATS_STOP(residual_timer);
+
+        // seed the potentials with the distances from the source (the reduced costs become non-negative),
+        // if there is a negative cycle Successive Shortest Path cannot be applied
+        if (!MinimumCostFlowAlgorithms::initPotentials(network, source)) {
             throw std::invalid_argument("The graph has a negative cycle, Successive Shortest Path cannot be applied");
         }
 
         // get the maximum flow using Edmonds-Karp (feasible flow)
-        auto edmonds_karps_result = MaximumFlowAlgorithms::EdmondsKarp(residual_graph, source, sink);
+        auto edmonds_karps_result = MaximumFlowAlgorithms::EdmondsKarp(graph, source, sink);
 
-        int num_nodes { residual_graph->getNumNodes() };
-        std::vector<int> imbalance(num_nodes, 0); // imbalance of each node
+        int num_nodes { network->getNumNodes() };
+        std::vector<types::accumulator_t> imbalance(num_nodes, 0); // imbalance of each node
         imbalance.at(source) = edmonds_karps_result->getFlow(); // imbalance of the source node is the max flow
         imbalance.at(sink) = -edmonds_karps_result->getFlow(); // imbalance of the sink node is the negative max flow
 
-        std::vector<int> potential(num_nodes, 0); // potential of each node 
-
         // container for the nodes with imbalance > 0
         std::vector<int> positive_imbalance;
-        positive_imbalance.push_back(source);
 
         // container for the nodes with imbalance < 0
         std::vector<int> negative_imbalance;
-        negative_imbalance.push_back(sink);
 
-        int flow {};
+        if (edmonds_karps_result->getFlow() > 0) {
+            positive_imbalance.push_back(source);
+            negative_imbalance.push_back(sink);
+        }
+
+        types::accumulator_t flow {};
+
+        // buffers of the shortest path searches and of the blocking flows
+        auto workspace = std::make_shared<data_structures::DijkstraWorkspace>(num_nodes);
+        std::vector<int> level(num_nodes, -1);
+        std::vector<int> current_arc(num_nodes);
 
         // if there are nodes with imbalance > 0 there also must be nodes with imbalance < 0
         while (!positive_imbalance.empty()) {
@@ -80,24 +102,41 @@ namespace algorithms {
             positive_imbalance.pop_back();
             int l { negative_imbalance.back() };
             negative_imbalance.pop_back();
+            NETWORK_FLOWS_STATS_ADD(Iterations, 1);
 
-            auto dijkstra_result = GraphBaseAlgorithms::Dijkstra(residual_graph, k);
-            auto distance = dijkstra_result->getDistance();
-            auto parent = dijkstra_result->getParent();
+            if (!MinimumCostFlowAlgorithms::shortestPaths(network, k, l, workspace)) {
+                throw std::runtime_error("Max flow not reached");
+            }
 
-            // get path between k and l
-            auto path = utils::GraphUtils::RetrievePath(parent, k, l);
+            // get the minimum imbalance between k and l
+            types::accumulator_t k_imbalance { imbalance.at(k) };
+            types::accumulator_t l_imbalance { imbalance.at(l) };
+            types::accumulator_t min_imbalance { std::min(k_imbalance, -l_imbalance) };
+
+            // update node potentials, the reduced costs follow them (see ResidualNetwork::getReducedCost())
+            NETWORK_FLOWS_STATS_TIMER(flow_update_timer, FlowUpdate);
+            network->updatePotentials(workspace, workspace->getDistance(l));
+
+            types::accumulator_t augment_flow {};
+            if (consts::ssp_blocking_flow) {
+                // the arcs with zero reduced cost form all the shortest paths from k to l
+                augment_flow = MinimumCostFlowAlgorithms::blockingFlow(network, k, l, min_imbalance, level, current_arc);
+                if (augment_flow == 0) {
+                    throw std::runtime_error("Max flow not reached");
+                }
+            } else {
+                NETWORK_FLOWS_STATS_ADD(Augmentations, 1);
 
-            // get the minimum residual capacity in the path
-            int residual_capacity { utils::GraphUtils::GetResidualCapacity(residual_graph, path) };
-            int k_imbalance { imbalance.at(k) };
-            int l_imbalance { imbalance.at(l) };
+                // get path between k and l and the minimum residual capacity in the path
+                auto path = utils::GraphUtils::RetrieveArcPath(network, workspace, k, l);
+                types::capacity_t residual_capacity { utils::GraphUtils::GetResidualCapacity(network, path) };
 
-            // get the minimum imbalance between k and l
-            int min_imbalance { std::min(k_imbalance, -l_imbalance) };
+                // get the augment flow (it fits in a capacity since it is not greater than the residual capacity)
+                augment_flow = std::min<types::accumulator_t>(residual_capacity, min_imbalance);
 
-            // get the augment flow
-            int augment_flow { std::min(residual_capacity, min_imbalance) }; 
+                // send the flow in the path and update the residual network
+                utils::GraphUtils::SendFlowInArcPath(network, path, static_cast<types::capacity_t>(augment_flow));
+            }
 
             // update imbalances
             imbalance.at(k) -= augment_flow;
@@ -109,167 +148,268 @@ namespace algorithms {
                 negative_imbalance.push_back(l);
             }
 
-            // update node potentials
-            for (int u = 0; u < num_nodes; u++) {
-                potential.at(u) = potential.at(u) - distance->at(u);
-            }
-            
-            // send the flow in the path and update the residual graph
-            utils::GraphUtils::SendFlowInPathReducedCosts(residual_graph, path, augment_flow); 
-            
-            // update reduced costs
-            for (int u = 0; u < num_nodes; u++) {
-                for (auto edge: *residual_graph->getNodeAdjList(u)) {
-                    if (edge.getCost() <= 0) {
-                        continue;
-                    }
-                    int new_weight { edge.getCost() - potential.at(u) + potential.at(edge.getSink()) };
-                    residual_graph->setEdgeCost(u, edge.getSink(), new_weight);
-                }
-            }
-
-            flow += augment_flow;
+            flow = utils::ArithmeticUtils::CheckedAdd<types::accumulator_t>(flow, augment_flow);
         }
 
         if (flow != edmonds_karps_result->getFlow()) {
             throw std::runtime_error("Max flow not reached");
         }
 
-        auto optimal_graph = utils::GraphUtils::GetOptimalGraph(residual_graph, graph);
-        int minimum_cost { MinimumCostFlowAlgorithms::getMinimumCost(optimal_graph) };
+        NETWORK_FLOWS_STATS_TIMER(solution_timer, Solution);
+        auto edge_flows = utils::GraphUtils::GetEdgeFlows(network, graph);
+        auto optimal_graph = utils::GraphUtils::GetOptimalGraph(graph, *edge_flows);
+        types::accumulator_t minimum_cost { MinimumCostFlowAlgorithms::getMinimumCost(optimal_graph) };
 
-        return std::make_shared<dto::FlowResult>(optimal_graph, minimum_cost);
+        return NETWORK_FLOWS_STATS_RESULT(stats,
+            std::make_shared<dto::FlowResult>(optimal_graph, edge_flows, minimum_cost));
     }
 
     std::shared_ptr<dto::FlowResult> MinimumCostFlowAlgorithms::PrimalDual(const std::shared_ptr<data_structures::Graph>& graph, int source, int sink) {
-        
-        // get the residual graph
-        auto residual_graph = utils::GraphUtils::GetResidualGraph(graph);
 
-        // check if there is a negative cycle, if so Successive Shortest Path cannot be applied
-        auto bellman_ford_result = GraphBaseAlgorithms::BellmanFord(residual_graph, source);
-        if (bellman_ford_result->hasNegativeCycle()) {
-            throw std::invalid_argument("The graph has a negative cycle, Successive Shortest Path cannot be applied");
-        }
+        NETWORK_FLOWS_STATS_SCOPE(stats);
 
-        // get the maximum flow using Edmonds-Karp
-        auto edmonds_karps_result = MaximumFlowAlgorithms::EdmondsKarp(residual_graph, source, sink);
+        // with zero costs every maximum flow is optimal
+        if (utils::GraphUtils::HasZeroCosts(graph)) {
+            return NETWORK_FLOWS_STATS_RESULT(stats, MinimumCostFlowAlgorithms::zeroCostFlow(graph, source, sink));
+        }
 
-        int num_nodes { residual_graph->getNumNodes() + 2 };
+        // the residual network keeps the residual capacity of every arc and the node potentials
+        // (the reduced costs are computed from them, see ResidualNetwork::getReducedCost())
+        NETWORK_FLOWS_STATS_TIMER(residual_timer, ResidualNetwork);
+        auto network = std::make_shared<data_structures::ResidualNetwork>(graph);
+        NETWORK_FLOWS_STATS_STOP(residual_timer);
 
-        int current_imbalance { edmonds_karps_result->getFlow() };  // current imbalance
-        std::vector<int> potential(num_nodes, 0);                   // potential of each node 
-        int flow {};                                                // current flow
+        // seed the potentials with the distances from the source (the reduced costs become non-negative),
+        // if there is a negative cycle Successive Shortest Path cannot be applied
+        if (!MinimumCostFlowAlgorithms::initPotentials(network, source)) {
+            throw std::invalid_argument("The graph has a negative cycle, Successive Shortest Path cannot be applied");
+        }
 
-        // add source edge
-        auto new_source { num_nodes - 2 };
-        residual_graph->addEdge(new_source, source, current_imbalance, 0);
+        // get the maximum flow using Edmonds-Karp
+        auto edmonds_karps_result = MaximumFlowAlgorithms::EdmondsKarp(graph, source, sink);
 
-        // add sink edge
-        auto new_sink { num_nodes - 1 };
-        residual_graph->addEdge(sink, new_sink, current_imbalance, 0);
+        types::accumulator_t current_imbalance { edmonds_karps_result->getFlow() }; // current imbalance
+        types::accumulator_t flow {};                                              // current flow
 
-        // get the original graph
-        auto original_graph = std::make_shared<data_structures::Graph>(residual_graph);
+        // buffers of the shortest path searches and of the blocking flows
+        auto workspace = std::make_shared<data_structures::DijkstraWorkspace>(network->getNumNodes());
+        std::vector<int> level(network->getNumNodes(), -1);
+        std::vector<int> current_arc(network->getNumNodes());
 
         while (current_imbalance > 0) {
-            // get the shortest path from source to sink
-            auto dijkstra_result = GraphBaseAlgorithms::Dijkstra(residual_graph, new_source);
-            auto distance = dijkstra_result->getDistance();
-            auto parent = dijkstra_result->getParent();
+            NETWORK_FLOWS_STATS_ADD(Iterations, 1);
 
-            for (int u = 0; u < num_nodes; u++) {
-                potential.at(u) = potential.at(u) - distance->at(u);
+            // get the shortest path from source to sink
+            if (!MinimumCostFlowAlgorithms::shortestPaths(network, source, sink, workspace)) {
+                throw std::runtime_error("Max flow not reached");
             }
-            
-            // update reduced costs
-            for (int u = 0; u < num_nodes; u++) {
-                for (auto edge: *residual_graph->getNodeAdjList(u)) {
-                    if (edge.getCost() <= 0) {
-                        continue;
-                    }
-                    int new_weight { edge.getCost() - potential.at(u) + potential.at(edge.getSink()) };
-                    residual_graph->setEdgeCost(u, edge.getSink(), new_weight);
+
+            // update node potentials: the arcs of the shortest paths become admissible (see ResidualNetwork::isAdmissible())
+            NETWORK_FLOWS_STATS_TIMER(admissible_timer, AdmissibleGraph);
+            network->updatePotentials(workspace, workspace->getDistance(sink));
+            NETWORK_FLOWS_STATS_STOP(admissible_timer);
+
+            // maximum flow on the admissible arcs, sent in place by blocking flows until none is left
+            NETWORK_FLOWS_STATS_TIMER(flow_update_timer, FlowUpdate);
+            types::accumulator_t admissible_flow {};
+            while (current_imbalance > 0) {
+                types::accumulator_t blocking_flow { MinimumCostFlowAlgorithms::blockingFlow(network, source, sink, current_imbalance,
+                    level, current_arc) };
+                if (blocking_flow == 0) {
+                    break;
                 }
+
+                admissible_flow += blocking_flow;
+                current_imbalance -= blocking_flow;
             }
-            // get admissible network 
-            auto admissible_graph = utils::GraphUtils::GetAdmissibleGraph(residual_graph);
-            
-            auto flow_result = MaximumFlowAlgorithms::EdmondsKarp(admissible_graph, new_source, new_sink);
-            int admissible_flow { flow_result->getFlow() };
-
-            auto flow_graph =  utils::GraphUtils::GetOptimalGraph(flow_result->getGraph(), residual_graph);
-            flow += admissible_flow;
-
-            // update current imbalance
-            current_imbalance -= admissible_flow;
-
-            // update residual graph with the flow found
-            // iterate over all the edges of flow_graph
-            for (int u = 0; u < num_nodes; u++) {
-                for (auto edge: *flow_graph->getNodeAdjList(u)) {
-
-                    int source { edge.getSource() };
-                    int sink { edge.getSink() };
-                    int edge_flow { edge.getCapacity() };
-
-                    // subtract flow from the residual capacity of the edge
-                    int capacity { residual_graph->getEdge(source, sink).getCapacity() };
-
-                    if (capacity < edge_flow) {
-                        throw std::invalid_argument("The flow is greater than the residual capacity of the edge");
-                    }
-
-                    capacity -= edge_flow;
-                    // if residual capacity is 0, remove the edge
-                    if (!capacity) {
-                        residual_graph->removeEdge(source, sink);
-                    } else {
-                        residual_graph->setEdgeCapacity(source, sink, capacity);
-                    }
-
-                    // if the reverse edge does not exist, add it
-                    if (edge_flow) {
-                        if (!residual_graph->hasEdge(sink, source)) {
-                            residual_graph->addEdge(sink, source, edge_flow, 0);
-                        } else {
-                            residual_graph->setEdgeCapacity(sink, source, residual_graph->getEdge(sink, source).getCapacity() + edge_flow);
-                        }
-                    }
-                }
+
+            if (admissible_flow == 0) {
+                throw std::runtime_error("Max flow not reached");
             }
+
+            flow = utils::ArithmeticUtils::CheckedAdd(flow, admissible_flow);
         }
 
         if (flow != edmonds_karps_result->getFlow()) {
             throw std::runtime_error("Max flow not reached");
         }
 
-        // remove the source and sink edges (both directions)
-        if (residual_graph->hasEdge(new_source, source)) {
-            residual_graph->removeEdge(new_source, source);
+        NETWORK_FLOWS_STATS_TIMER(solution_timer, Solution);
+        auto edge_flows = utils::GraphUtils::GetEdgeFlows(network, graph);
+        auto optimal_graph = utils::GraphUtils::GetOptimalGraph(graph, *edge_flows);
+        types::accumulator_t minimum_cost { MinimumCostFlowAlgorithms::getMinimumCost(optimal_graph) };
+
+        return NETWORK_FLOWS_STATS_RESULT(stats,
+            std::make_shared<dto::FlowResult>(optimal_graph, edge_flows, minimum_cost));
+    }
+
+    std::shared_ptr<dto::FlowResult> MinimumCostFlowAlgorithms::MinimumCostCirculation(const std::shared_ptr<data_structures::Graph>& graph) {
+        // the residual network of the zero flow
+        NETWORK_FLOWS_STATS_TIMER(residual_timer, ResidualNetwork);
+        auto network = std::make_shared<data_structures::ResidualNetwork>(graph);
+        NETWORK_FLOWS_STATS_STOP(residual_timer);
+
+        MinimumCostFlowAlgorithms::cancelNegativeCycles(network);
+
+        NETWORK_FLOWS_STATS_TIMER(solution_timer, Solution);
+        auto edge_flows = utils::GraphUtils::GetEdgeFlows(network, graph);
+        auto optimal_graph = utils::GraphUtils::GetOptimalGraph(graph, *edge_flows);
+        types::accumulator_t minimum_cost { MinimumCostFlowAlgorithms::getMinimumCost(optimal_graph) };
+
+        return std::make_shared<dto::FlowResult>(optimal_graph, edge_flows, minimum_cost);
+    }
+
+    void MinimumCostFlowAlgorithms::cancelNegativeCycles(const std::shared_ptr<data_structures::ResidualNetwork>& network) {
+        while (true) {
+            NETWORK_FLOWS_STATS_TIMER(negative_cycle_timer, NegativeCycle);
+            auto negative_cycles = ParallelShortestPathAlgorithms::NegativeCycles(network);
+            NETWORK_FLOWS_STATS_STOP(negative_cycle_timer);
+
+            if (negative_cycles.empty()) {
+                break;
+            }
+
+            // the cycles do not share nodes (so neither arcs): each one is augmented with its own residual capacity
+            NETWORK_FLOWS_STATS_TIMER(flow_update_timer, FlowUpdate);
+            for (const auto& negative_cycle : negative_cycles) {
+                NETWORK_FLOWS_STATS_ADD(CyclesCancelled, 1);
+                types::capacity_t residual_capacity { utils::GraphUtils::GetResidualCapacity(network, negative_cycle) };
+                utils::GraphUtils::SendFlowInArcPath(network, negative_cycle, residual_capacity);
+            }
+        }
+    }
+
+    bool MinimumCostFlowAlgorithms::initPotentials(const std::shared_ptr<data_structures::ResidualNetwork>& network, int source) {
+        NETWORK_FLOWS_STATS_TIMER(negative_cycle_timer, NegativeCycle);
+        auto bellman_ford_result = ParallelShortestPathAlgorithms::ShouldRunInParallel(network)
+            ? ParallelShortestPathAlgorithms::BellmanFord(network, source)
+            : GraphBaseAlgorithms::BellmanFord(network, source);
+
+        if (bellman_ford_result->hasNegativeCycle()) {
+            return false;
+        }
+
+        network->initPotentials(*bellman_ford_result->getDistance());
+        return true;
+    }
+
+    types::accumulator_t MinimumCostFlowAlgorithms::blockingFlow(const std::shared_ptr<data_structures::ResidualNetwork>& network,
+        int source, int sink, types::accumulator_t max_flow, std::vector<int>& level, std::vector<int>& current_arc) {
+
+        // label the nodes with their distance from the source on the admissible arcs (the labeled list is the queue),
+        // the nodes at the level of the sink or farther are not expanded
+        std::vector<int> labeled { source };
+        level[source] = 0;
+        for (std::size_t i = 0; i < labeled.size(); i++) {
+            int node { labeled[i] };
+            current_arc[node] = network->getFirstArc(node);
+            if (level[sink] >= 0 && level[node] >= level[sink]) {
+                continue;
+            }
+
+            for (int arc = network->getFirstArc(node); arc < network->getLastArc(node); arc++) {
+                int head { network->getHead(arc) };
+                if (level[head] < 0 && network->isAdmissible(arc)) {
+                    level[head] = level[node] + 1;
+                    labeled.push_back(head);
+                }
+            }
+        }
+
+        // send flow on the paths of the layered network (depth-first, each arc is skipped at most once)
+        types::accumulator_t flow {};
+        std::vector<int> path;
+        int node { source };
+        while (level[sink] >= 0 && flow < max_flow) {
+            if (node == sink) {
+                NETWORK_FLOWS_STATS_ADD(Augmentations, 1);
+                types::accumulator_t path_flow { max_flow - flow };
+                for (int arc : path) {
+                    path_flow = std::min<types::accumulator_t>(path_flow, network->getResidualCapacity(arc));
+                }
+                for (int arc : path) {
+                    network->pushFlow(arc, static_cast<types::capacity_t>(path_flow));
+                }
+                flow += path_flow;
+
+                // restart from the tail of the first saturated arc
+                auto saturated = std::find_if(path.begin(), path.end(), [&network](int arc) {
+                    return network->getResidualCapacity(arc) == 0;
+                });
+                node = saturated == path.end() ? sink : network->getTail(*saturated);
+                path.erase(saturated, path.end());
+                continue;
+            }
+
+            // advance on the current arc of the node, or retreat if it has no admissible arc left
+            int& arc { current_arc[node] };
+            while (arc < network->getLastArc(node) && (level[network->getHead(arc)] != level[node] + 1 || !network->isAdmissible(arc))) {
+                arc++;
+            }
+
+            if (arc < network->getLastArc(node)) {
+                path.push_back(arc);
+                node = network->getHead(arc);
+            } else if (node == source) {
+                break;
+            } else {
+                node = network->getTail(path.back());
+                path.pop_back();
+                current_arc[node]++;
+            }
         }
-        if (residual_graph->hasEdge(source, new_source)) {
-            residual_graph->removeEdge(source, new_source);
+
+        // reset only the labeled nodes
+        for (int labeled_node : labeled) {
+            level[labeled_node] = -1;
+        }
+
+        return flow;
+    }
+
+    bool MinimumCostFlowAlgorithms::shortestPaths(const std::shared_ptr<data_structures::ResidualNetwork>& network, int source, int target,
+        const std::shared_ptr<data_structures::DijkstraWorkspace>& workspace) {
+
+        NETWORK_FLOWS_STATS_TIMER(shortest_paths_timer, ShortestPaths);
+        if (!ParallelShortestPathAlgorithms::ShouldRunInParallel(network)) {
+            return GraphBaseAlgorithms::Dijkstra(network, source, target, workspace);
         }
-        if (residual_graph->hasEdge(sink, new_sink)) {
-            residual_graph->removeEdge(sink, new_sink);
+
+        // delta-stepping computes every distance, keep the nodes closer than the target as if they were settled
+        auto delta_stepping_result = ParallelShortestPathAlgorithms::DeltaStepping(network, source);
+        const auto& distance = *delta_stepping_result->getDistance();
+        const auto& parent_arc = *delta_stepping_result->getParentArc();
+        if (distance[target] == consts::infinite_distance) {
+            return false;
         }
-        if (residual_graph->hasEdge(new_sink, sink)) {
-            residual_graph->removeEdge(new_sink, sink);
+
+        workspace->reset();
+        for (int node = 0; node < network->getNumNodes(); node++) {
+            if (distance[node] <= distance[target]) {
+                workspace->reach(node, distance[node], parent_arc[node]);
+                workspace->settle(node);
+            }
         }
 
-        auto optimal_graph = utils::GraphUtils::GetOptimalGraph(residual_graph, graph);
-        int minimum_cost { MinimumCostFlowAlgorithms::getMinimumCost(optimal_graph) };
+        return true;
+    }
+
+    std::shared_ptr<dto::FlowResult> MinimumCostFlowAlgorithms::zeroCostFlow(const std::shared_ptr<data_structures::Graph>& graph,
+        int source, int sink) {
+
+        // the result of a maximum flow algorithm holds the optimal graph
+        auto edmonds_karps_result = MaximumFlowAlgorithms::EdmondsKarp(graph, source, sink);
 
-        return std::make_shared<dto::FlowResult>(optimal_graph, minimum_cost);        
+        return std::make_shared<dto::FlowResult>(edmonds_karps_result->getGraph(), edmonds_karps_result->getEdgeFlows(), 0);
     }
 
-    int MinimumCostFlowAlgorithms::getMinimumCost(const std::shared_ptr<data_structures::Graph>& graph) {
-        int minimum_cost {};
+    types::accumulator_t MinimumCostFlowAlgorithms::getMinimumCost(const std::shared_ptr<data_structures::Graph>& graph) {
+        types::accumulator_t minimum_cost {};
         // compute the minimum cost using the optimal graph
         for (int u = 0; u < graph->getNumNodes(); u++) {
             for (auto edge: *graph->getNodeAdjList(u)) {
-                minimum_cost +=  edge.getCost() * edge.getCapacity();
+                auto edge_cost { utils::ArithmeticUtils::CheckedMul<types::accumulator_t>(edge.getCost(), edge.getCapacity()) };
+                minimum_cost = utils::ArithmeticUtils::CheckedAdd(minimum_cost, edge_cost);
             }
         }
 
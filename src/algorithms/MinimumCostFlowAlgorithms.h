@@ -2,9 +2,14 @@
 #define MINIMUM_COST_FLOWS_PROBLEM_MINIMUMCOSTFLOWALGORITHMS_H
 
 #include "dto/flowResult/FlowResult.h"
+#include "types/Types.h"
 #include "data_structures/graph/Graph.h"
+#include "data_structures/graph/ResidualNetwork.h"
+#include "data_structures/workspace/DijkstraWorkspace.h"
+#include "dto/dijkstra/DijkstraResult.h"
 
 #include <memory>
+#include <vector>
 
 namespace algorithms {
     /**
@@ -22,6 +27,8 @@ namespace algorithms {
              * This algorithm maintains a feasible solution x in the network G and proceeds by augmenting flows along negative 
              * cost directed cycles in the residual network G(x) and thereby canceling them
              * Return the residual graph and the minimum weight flow of the path between source and sink.
+             * The negative cycles are searched in the whole residual network, in parallel, and each search returns
+             * many vertex-disjoint cycles that are cancelled together (see ParallelShortestPathAlgorithms::NegativeCycles()).
              *
              * (see: https://complex-systems-ai.com/en/maximum-flow-problem/cycle-canceling-algorithm/)
              * 
@@ -46,6 +53,9 @@ namespace algorithms {
              * a node s with excess supply and a node t with unfulfilled demand and sends flow
              * from s to t along a shortest path in the residual network. The algorithm terminates
              * when the current solution satisfies all the mass balance constraints.
+             * With consts::ssp_blocking_flow, after each shortest path computation the flow is sent on all the
+             * shortest paths at once (see blockingFlow()), so networks with many routes of equal cost need
+             * far fewer shortest path computations.
              * 
              * (see: https://www.topcoder.com/thrive/articles/Minimum%20Cost%20Flow%20Part%20Two:%20Algorithms)
              * 
@@ -65,6 +75,10 @@ namespace algorithms {
 
             /**
              * Primal-Dual algorithm.
+             * After each shortest path computation the potentials are updated, so the admissible arcs
+             * (see ResidualNetwork::isAdmissible()) are the arcs of the shortest paths; then a maximum flow
+             * on the admissible arcs is sent in place on the residual network by blocking flows
+             * (see blockingFlow()), without building any graph.
              *
              * @param graph  the graph to solve
              * @param source the source node
@@ -73,16 +87,111 @@ namespace algorithms {
              * @return the minimum weight flow
              */
             static std::shared_ptr<dto::FlowResult> PrimalDual(const std::shared_ptr<data_structures::Graph>& graph, int source, int sink);
+
+            /**
+             * Minimum cost circulation: the minimum cost flow of a graph without supplies (no source and no sink).
+             * Starting from the zero flow, the negative cycles of the residual network are cancelled
+             * as in CycleCancelling(), so with non-negative costs the zero flow is returned.
+             *
+             * V: number of nodes
+             * E: number of edges
+             * U: maximum capacity
+             * C: maximum absolute value of cost
+             * Time complexity: O(V * E^2 * C * U)
+             *
+             * @param graph the graph to solve
+             *
+             * @return the optimal graph, the flow of each edge and the minimum cost
+             */
+            static std::shared_ptr<dto::FlowResult> MinimumCostCirculation(const std::shared_ptr<data_structures::Graph>& graph);
         
         private:
+            /**
+             * Cancel the negative cycles of the residual network until there are none left,
+             * many vertex-disjoint cycles at a time (see ParallelShortestPathAlgorithms::NegativeCycles()).
+             *
+             * @param network the residual network of a feasible flow, the cycles are cancelled on it
+             */
+            static void cancelNegativeCycles(const std::shared_ptr<data_structures::ResidualNetwork>& network);
+
+            /**
+             * Minimum cost flow of a graph where every edge has cost 0.
+             * Every maximum flow is optimal, so the maximum flow kernel is used directly.
+             *
+             * @param graph  the graph to solve
+             * @param source the source node
+             * @param sink   the sink node
+             *
+             * @return the graph with the flow of each edge and the minimum cost (always 0)
+             */
+            static std::shared_ptr<dto::FlowResult> zeroCostFlow(const std::shared_ptr<data_structures::Graph>& graph, int source, int sink);
+
+            /**
+             * Seed the node potentials of the residual network with the distances from the source
+             * (see ResidualNetwork::initPotentials()), so that the first shortest path computation already
+             * runs on non-negative reduced costs. The distances are computed by Bellman-Ford, parallel on
+             * large networks (see ParallelShortestPathAlgorithms::ShouldRunInParallel()), which also
+             * detects the negative cycles reachable from the source.
+             *
+             * @param network the residual network without flow
+             * @param source  the source node
+             *
+             * @return true if the potentials were set, false if there is a negative cycle
+             *
+             * @throws overflow_error if a reduced cost could overflow
+             */
+            static bool initPotentials(const std::shared_ptr<data_structures::ResidualNetwork>& network, int source);
+
+            /**
+             * Send a blocking flow from the source to the sink on the admissible arcs of the residual network
+             * (see ResidualNetwork::isAdmissible()), as a phase of Dinic's algorithm:
+             * the admissible arcs are layered by a breadth-first search from the source, then a depth-first search
+             * with a current arc per node sends flow on the paths of the layered network until it has none left.
+             * After a shortest path computation and the update of the potentials the admissible paths
+             * are all the shortest paths, so one computation sends the flow of many paths.
+             * Only the nodes reached from the source are visited, the buffers are reset before returning.
+             *
+             * V': number of nodes reached on the admissible arcs
+             * E': number of arcs leaving them
+             * Time complexity: O(V' * E')
+             *
+             * @param network     the residual network, the flow is sent on it
+             * @param source      the source node
+             * @param sink        the sink node
+             * @param max_flow    the maximum flow to send
+             * @param level       buffer of V elements, all -1
+             * @param current_arc buffer of V elements
+             *
+             * @return the flow sent
+             */
+            static types::accumulator_t blockingFlow(const std::shared_ptr<data_structures::ResidualNetwork>& network, int source, int sink,
+                types::accumulator_t max_flow, std::vector<int>& level, std::vector<int>& current_arc);
+
+            /**
+             * Compute the shortest path from the source to the target using the reduced costs: delta-stepping on large
+             * networks, otherwise Dijkstra, which stops at the target (see ParallelShortestPathAlgorithms::ShouldRunInParallel()).
+             * The result is stored in the workspace: the nodes settled closer than the target and the parent arcs.
+             *
+             * @param network   the residual network
+             * @param source    the source node
+             * @param target    the target node
+             * @param workspace the workspace of the search
+             *
+             * @return true if the target was reached, false otherwise
+             */
+            static bool shortestPaths(const std::shared_ptr<data_structures::ResidualNetwork>& network, int source, int target,
+                const std::shared_ptr<data_structures::DijkstraWorkspace>& workspace);
+
             /**
              * Get the minimum cost of the residual graph after applying a minimum cost flow algorithm.
              * 
              * @param graph the graph from which to get the minimum cost
              * 
-             * @return int the minimum cost 
+             * @return the minimum cost
+             *
+             * @throws overflow_error if the cost does not fit in 64 bits
              */
-            static int getMinimumCost(const std::shared_ptr<data_structures::Graph>& graph);
+            static types::accumulator_t getMinimumCost(const std::shared_ptr<data_structures::Graph>& graph);
     };
 }
 
@@ -0,0 +1,371 @@
+#include "ParallelShortestPathAlgorithms.h"
+
+#include "consts/Consts.h"
+#include "utils/ThreadPool.h"
+#include "utils/ArithmeticUtils.h"
+#include "utils/Stats.h"
+#include "GraphBaseAlgorithms.h"
+
+#include <map>
+#include <queue>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+
+namespace algorithms {
+    bool ParallelShortestPathAlgorithms::ShouldRunInParallel(const std::shared_ptr<data_structures::ResidualNetwork>& network) {
+        return network->getNumArcs() >= consts::parallel_min_arcs && utils::ThreadPool::GetInstance()->getNumThreads() > 1
+            && !utils::ThreadPool::InParallelLoop();
+    }
+
+    std::shared_ptr<dto::BellmanFordResult> ParallelShortestPathAlgorithms::BellmanFord(const std::shared_ptr<data_structures::ResidualNetwork>& network,
+        int source) {
+
+        NETWORK_FLOWS_STATS_ADD(BellmanFordCalls, 1);
+        int num_nodes { network->getNumNodes() };
+        auto pool = utils::ThreadPool::GetInstance();
+
+        std::vector<std::atomic<types::accumulator_t>> dist(num_nodes);
+        std::vector<std::atomic<bool>> in_frontier(num_nodes);
+        for (int node = 0; node < num_nodes; node++) {
+            dist[node].store(consts::infinite_distance, std::memory_order_relaxed);
+            in_frontier[node].store(false, std::memory_order_relaxed);
+        }
+        dist[source].store(0, std::memory_order_relaxed);
+
+        // the frontier contains the nodes whose distance changed in the previous round
+        std::vector<int> frontier { source };
+        std::vector<std::vector<int>> next_frontier(pool->getNumThreads());
+
+        // after round i the distances are correct for the paths with at most i + 1 arcs,
+        // so without negative cycles the frontier is empty after |V| rounds
+        for (int round = 0; round < num_nodes && !frontier.empty(); round++) {
+            pool->parallelFor(static_cast<int>(frontier.size()), consts::parallel_grain, [&](int begin, int end, int thread) {
+                auto& local_frontier = next_frontier[thread];
+
+                for (int i = begin; i < end; i++) {
+                    int node { frontier[i] };
+                    types::accumulator_t node_dist { dist[node].load(std::memory_order_relaxed) };
+                    NETWORK_FLOWS_STATS_ADD(NodesScanned, 1);
+                    NETWORK_FLOWS_STATS_ADD(ArcsRelaxed, network->getLastArc(node) - network->getFirstArc(node));
+
+                    for (int arc = network->getFirstArc(node); arc < network->getLastArc(node); arc++) {
+                        if (network->getResidualCapacity(arc) <= 0) {
+                            continue;
+                        }
+
+                        int sink { network->getHead(arc) };
+                        auto new_dist { utils::ArithmeticUtils::CheckedAdd<types::accumulator_t>(node_dist, network->getCost(arc)) };
+
+                        // add the node to the next frontier only once
+                        if (ParallelShortestPathAlgorithms::atomicMin(dist[sink], new_dist) && !in_frontier[sink].exchange(true)) {
+                            local_frontier.push_back(sink);
+                        }
+                    }
+                }
+            });
+
+            frontier.clear();
+            for (auto& local_frontier : next_frontier) {
+                frontier.insert(frontier.end(), local_frontier.begin(), local_frontier.end());
+                local_frontier.clear();
+            }
+            for (int node : frontier) {
+                in_frontier[node].store(false, std::memory_order_relaxed);
+            }
+        }
+
+        // negative cycle: retrieve it with the sequential algorithm
+        if (!frontier.empty()) {
+            return GraphBaseAlgorithms::BellmanFord(network, source);
+        }
+
+        auto distance = std::make_shared<std::vector<types::accumulator_t>>(num_nodes);
+        for (int node = 0; node < num_nodes; node++) {
+            (*distance)[node] = dist[node].load(std::memory_order_relaxed);
+        }
+
+        auto parent = std::make_shared<std::vector<int>>();
+        std::vector<int> parent_arc {};
+        ParallelShortestPathAlgorithms::buildShortestPathTree(network, source, *distance, false, *parent, parent_arc);
+
+        return std::make_shared<dto::BellmanFordResult>(distance, parent);
+    }
+
+    std::shared_ptr<dto::DijkstraResult> ParallelShortestPathAlgorithms::DeltaStepping(const std::shared_ptr<data_structures::ResidualNetwork>& network,
+        int source) {
+
+        NETWORK_FLOWS_STATS_ADD(DijkstraCalls, 1);
+        int num_nodes { network->getNumNodes() };
+        int num_arcs { network->getNumArcs() };
+        auto pool = utils::ThreadPool::GetInstance();
+        int num_threads { pool->getNumThreads() };
+
+        // the bucket width is the average reduced cost of the residual arcs: it is only a heuristic,
+        // so the sum is accumulated in long double, where it cannot overflow, and the average is clamped
+        std::vector<long double> thread_cost_sum(num_threads, 0);
+        std::vector<long long> thread_arc_count(num_threads, 0);
+        pool->parallelFor(num_arcs, consts::parallel_grain * 64, [&](int begin, int end, int thread) {
+            for (int arc = begin; arc < end; arc++) {
+                if (network->getResidualCapacity(arc) > 0) {
+                    thread_cost_sum[thread] += static_cast<long double>(network->getReducedCost(arc));
+                    thread_arc_count[thread]++;
+                }
+            }
+        });
+        long double cost_sum {};
+        long long arc_count {};
+        for (int thread = 0; thread < num_threads; thread++) {
+            cost_sum += thread_cost_sum[thread];
+            arc_count += thread_arc_count[thread];
+        }
+        long double average_cost { arc_count ? cost_sum / static_cast<long double>(arc_count) : 1 };
+        types::accumulator_t delta { std::max<types::accumulator_t>(1, static_cast<types::accumulator_t>(
+            std::min<long double>(average_cost, static_cast<long double>(std::numeric_limits<types::accumulator_t>::max() / 2)))) };
+
+        std::vector<std::atomic<types::accumulator_t>> dist(num_nodes);
+        for (int node = 0; node < num_nodes; node++) {
+            dist[node].store(consts::infinite_distance, std::memory_order_relaxed);
+        }
+        dist[source].store(0, std::memory_order_relaxed);
+
+        // buckets of nodes by distance / delta, a node is in at most one bucket list at a time
+        std::map<types::accumulator_t, std::vector<int>> buckets {};
+        std::vector<types::accumulator_t> queued_bucket(num_nodes, -1);
+        std::vector<types::accumulator_t> settled_bucket(num_nodes, -1);
+        auto insert = [&](int node) {
+            types::accumulator_t bucket { dist[node].load(std::memory_order_relaxed) / delta };
+            if (queued_bucket[node] != bucket) {
+                buckets[bucket].push_back(node);
+                queued_bucket[node] = bucket;
+            }
+        };
+        insert(source);
+
+        std::vector<std::vector<int>> improved(num_threads);
+        auto insertImproved = [&]() {
+            for (auto& local_improved : improved) {
+                for (int node : local_improved) {
+                    insert(node);
+                }
+                local_improved.clear();
+            }
+        };
+
+        // relax the light (reduced cost <= delta) or the heavy arcs of the nodes
+        auto relax = [&](const std::vector<int>& nodes, bool light) {
+            pool->parallelFor(static_cast<int>(nodes.size()), consts::parallel_grain, [&](int begin, int end, int thread) {
+                auto& local_improved = improved[thread];
+
+                for (int i = begin; i < end; i++) {
+                    int node { nodes[i] };
+                    types::accumulator_t node_dist { dist[node].load(std::memory_order_relaxed) };
+                    NETWORK_FLOWS_STATS_ADD(NodesScanned, 1);
+                    NETWORK_FLOWS_STATS_ADD(ArcsRelaxed, network->getLastArc(node) - network->getFirstArc(node));
+
+                    for (int arc = network->getFirstArc(node); arc < network->getLastArc(node); arc++) {
+                        types::accumulator_t reduced_cost { network->getReducedCost(arc) };
+                        if (network->getResidualCapacity(arc) <= 0 || (reduced_cost <= delta) != light) {
+                            continue;
+                        }
+
+                        int sink { network->getHead(arc) };
+                        auto new_dist { utils::ArithmeticUtils::CheckedAdd(node_dist, reduced_cost) };
+                        if (ParallelShortestPathAlgorithms::atomicMin(dist[sink], new_dist)) {
+                            local_improved.push_back(sink);
+                        }
+                    }
+                }
+            });
+        };
+
+        std::vector<int> current {};
+        std::vector<int> settled {};
+        while (!buckets.empty()) {
+            types::accumulator_t bucket { buckets.begin()->first };
+            settled.clear();
+
+            // the light arcs can insert nodes again in the current bucket
+            while (buckets.count(bucket)) {
+                current.clear();
+                for (int node : buckets.at(bucket)) {
+                    if (queued_bucket[node] == bucket) {
+                        queued_bucket[node] = -1;
+                        current.push_back(node);
+                        if (settled_bucket[node] != bucket) {
+                            settled_bucket[node] = bucket;
+                            settled.push_back(node);
+                        }
+                    }
+                }
+                buckets.erase(bucket);
+
+                relax(current, true);
+                insertImproved();
+            }
+
+            // the heavy arcs lead to the next buckets, they are relaxed once per node
+            relax(settled, false);
+            insertImproved();
+        }
+
+        auto distance = std::make_shared<std::vector<types::accumulator_t>>(num_nodes);
+        for (int node = 0; node < num_nodes; node++) {
+            (*distance)[node] = dist[node].load(std::memory_order_relaxed);
+        }
+
+        auto parent = std::make_shared<std::vector<int>>();
+        auto parent_arc = std::make_shared<std::vector<int>>();
+        ParallelShortestPathAlgorithms::buildShortestPathTree(network, source, *distance, true, *parent, *parent_arc);
+
+        return std::make_shared<dto::DijkstraResult>(distance, parent, parent_arc);
+    }
+
+    bool ParallelShortestPathAlgorithms::atomicMin(std::atomic<types::accumulator_t>& distance, types::accumulator_t new_distance) {
+        types::accumulator_t current { distance.load(std::memory_order_relaxed) };
+        while (new_distance < current) {
+            if (distance.compare_exchange_weak(current, new_distance, std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::vector<std::shared_ptr<std::vector<int>>> ParallelShortestPathAlgorithms::NegativeCycles(
+        const std::shared_ptr<data_structures::ResidualNetwork>& network) {
+
+        NETWORK_FLOWS_STATS_ADD(BellmanFordCalls, 1);
+        int num_nodes { network->getNumNodes() };
+        auto pool = utils::ThreadPool::GetInstance();
+
+        // every node is reached from the virtual root with distance 0
+        std::vector<types::accumulator_t> dist(num_nodes, 0);
+        std::vector<types::accumulator_t> next_dist(num_nodes, 0);
+        std::vector<int> parent_arc(num_nodes, -1);
+        std::vector<std::uint8_t> thread_changed(pool->getNumThreads());
+
+        while (true) {
+            std::fill(thread_changed.begin(), thread_changed.end(), 0);
+
+            pool->parallelFor(num_nodes, consts::parallel_grain, [&](int begin, int end, int thread) {
+                bool changed { false };
+
+                for (int node = begin; node < end; node++) {
+                    types::accumulator_t node_dist { dist[node] };
+                    NETWORK_FLOWS_STATS_ADD(NodesScanned, 1);
+                    NETWORK_FLOWS_STATS_ADD(ArcsRelaxed, network->getLastArc(node) - network->getFirstArc(node));
+
+                    // the arcs entering the node are the twins of the arcs leaving it
+                    for (int arc = network->getFirstArc(node); arc < network->getLastArc(node); arc++) {
+                        int entering_arc { network->getTwin(arc) };
+                        if (network->getResidualCapacity(entering_arc) <= 0) {
+                            continue;
+                        }
+
+                        auto new_dist { utils::ArithmeticUtils::CheckedAdd<types::accumulator_t>(dist[network->getHead(arc)],
+                            network->getCost(entering_arc)) };
+                        if (new_dist < node_dist) {
+                            node_dist = new_dist;
+                            parent_arc[node] = entering_arc;
+                            changed = true;
+                        }
+                    }
+
+                    next_dist[node] = node_dist;
+                }
+
+                if (changed) {
+                    thread_changed[thread] = 1;
+                }
+            });
+
+            // no distance changed: there is no negative cycle
+            if (std::none_of(thread_changed.begin(), thread_changed.end(), [](std::uint8_t changed) { return changed; })) {
+                return {};
+            }
+
+            dist.swap(next_dist);
+
+            auto cycles = ParallelShortestPathAlgorithms::parentCycles(network, parent_arc);
+            if (!cycles.empty()) {
+                return cycles;
+            }
+        }
+    }
+
+    std::vector<std::shared_ptr<std::vector<int>>> ParallelShortestPathAlgorithms::parentCycles(
+        const std::shared_ptr<data_structures::ResidualNetwork>& network, const std::vector<int>& parent_arc) {
+
+        int num_nodes { network->getNumNodes() };
+        std::vector<std::shared_ptr<std::vector<int>>> cycles;
+
+        // walk[u] is the first node of the walk that visited u (-1 if not visited yet)
+        std::vector<int> walk(num_nodes, -1);
+        for (int start = 0; start < num_nodes; start++) {
+            int node { start };
+            while (node >= 0 && walk[node] < 0) {
+                walk[node] = start;
+                node = parent_arc[node] < 0 ? -1 : network->getTail(parent_arc[node]);
+            }
+
+            // the walk stopped on a node it visited: the parent arcs from that node form a cycle
+            if (node < 0 || walk[node] != start) {
+                continue;
+            }
+
+            auto cycle = std::make_shared<std::vector<int>>();
+            types::accumulator_t cycle_cost {};
+            int cycle_node { node };
+            do {
+                int arc { parent_arc[cycle_node] };
+                cycle->push_back(arc);
+                cycle_cost = utils::ArithmeticUtils::CheckedAdd<types::accumulator_t>(cycle_cost, network->getCost(arc));
+                cycle_node = network->getTail(arc);
+            } while (cycle_node != node);
+
+            if (cycle_cost < 0) {
+                std::reverse(cycle->begin(), cycle->end());
+                cycles.push_back(cycle);
+            }
+        }
+
+        return cycles;
+    }
+
+    void ParallelShortestPathAlgorithms::buildShortestPathTree(const std::shared_ptr<data_structures::ResidualNetwork>& network, int source,
+        const std::vector<types::accumulator_t>& distance, bool reduced_costs, std::vector<int>& parent, std::vector<int>& parent_arc) {
+
+        int num_nodes { network->getNumNodes() };
+        parent.assign(num_nodes, -1);
+        parent_arc.assign(num_nodes, -1);
+        parent[source] = consts::source_parent;
+
+        std::vector<bool> visited(num_nodes, false);
+        visited[source] = true;
+
+        std::queue<int> q {};
+        q.push(source);
+
+        while (!q.empty()) {
+            int node { q.front() };
+            q.pop();
+
+            for (int arc = network->getFirstArc(node); arc < network->getLastArc(node); arc++) {
+                int sink { network->getHead(arc) };
+                if (visited[sink] || network->getResidualCapacity(arc) <= 0) {
+                    continue;
+                }
+
+                types::accumulator_t cost { reduced_costs ? network->getReducedCost(arc) : network->getCost(arc) };
+                if (utils::ArithmeticUtils::CheckedAdd(distance[node], cost) == distance[sink]) {
+                    visited[sink] = true;
+                    parent[sink] = node;
+                    parent_arc[sink] = arc;
+                    q.push(sink);
+                }
+            }
+        }
+    }
+}
\ No newline at end of file
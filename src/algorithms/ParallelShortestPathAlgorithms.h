@@ -0,0 +1,137 @@
+#ifndef MINIMUM_COST_FLOWS_PROBLEM_PARALLELSHORTESTPATHALGORITHMS_H
+#define MINIMUM_COST_FLOWS_PROBLEM_PARALLELSHORTESTPATHALGORITHMS_H
+
+#include "types/Types.h"
+#include "dto/dijkstra/DijkstraResult.h"
+#include "dto/bellmanFord/BellmanFordResult.h"
+#include "data_structures/graph/ResidualNetwork.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace algorithms {
+    /**
+     * Class containing the following multithreaded shortest path algorithms on residual networks:
+     * - Frontier-based Bellman-Ford -> used with negative costs (e.g. to detect negative cycles)
+     * - Delta-stepping -> used with non-negative reduced costs, in place of Dijkstra.
+     * - Negative cycles detection -> used by Cycle-Cancelling to find many cycles at a time.
+     * They run on the shared thread pool (see utils::ThreadPool) and relax the arcs
+     * concurrently using an atomic minimum on the distances (or, for the negative cycles, one writer per node).
+     */
+    class ParallelShortestPathAlgorithms {
+        public:
+            /**
+             * Check if the parallel algorithms are worth using on the network:
+             * the shared pool has more than one thread, the calling thread is not inside a parallel loop
+             * (see utils::ThreadPool::InParallelLoop()) and the network has at least
+             * consts::parallel_min_arcs arcs (on smaller networks the synchronization costs more than the work).
+             *
+             * @param network the residual network
+             *
+             * @return true if the parallel algorithms should be used, false otherwise
+             */
+            static bool ShouldRunInParallel(const std::shared_ptr<data_structures::ResidualNetwork>& network);
+
+            /**
+             * Frontier-based parallel Bellman-Ford algorithm.
+             * At each round the nodes whose distance changed in the previous round (the frontier)
+             * are split among the threads, which relax their arcs with positive residual capacity using their costs.
+             * If the frontier is not empty after |V| rounds there is a negative cycle: in that case
+             * the cycle is retrieved using the sequential algorithm (see GraphBaseAlgorithms::BellmanFord()).
+             *
+             * V: number of nodes
+             * E: number of edges
+             * P: number of threads
+             * Time complexity: O(V * E / P) (worst case)
+             *
+             * @param network the residual network
+             * @param source  the source node
+             *
+             * @return the result of the algorithm (see BellmanFordResult.h)
+             */
+            static std::shared_ptr<dto::BellmanFordResult> BellmanFord(const std::shared_ptr<data_structures::ResidualNetwork>& network, int source);
+
+            /**
+             * Parallel delta-stepping algorithm (Meyer and Sanders).
+             * The nodes are kept in buckets of width delta according to their distance; the buckets are
+             * settled in increasing order, relaxing in parallel the light arcs (reduced cost <= delta)
+             * until the bucket is empty and then the heavy arcs of the nodes removed from it.
+             * Only the arcs with positive residual capacity are relaxed, using their reduced costs
+             * (see ResidualNetwork::getReducedCost()), that must be non-negative.
+             *
+             * (see: https://en.wikipedia.org/wiki/Parallel_single-source_shortest_path_algorithm#Delta_stepping_algorithm)
+             *
+             * @param network the residual network
+             * @param source  the source node
+             *
+             * @return the result of the algorithm, with the same content as GraphBaseAlgorithms::Dijkstra() (see DijkstraResult.h)
+             */
+            static std::shared_ptr<dto::DijkstraResult> DeltaStepping(const std::shared_ptr<data_structures::ResidualNetwork>& network, int source);
+
+            /**
+             * Find vertex-disjoint negative cycles anywhere in the residual network, not only the ones
+             * reachable from a node: the search starts from a virtual root connected to every node by
+             * an arc of cost 0, so every node starts with distance 0.
+             * At each round every node takes, in parallel, the minimum over its entering arcs with positive
+             * residual capacity (the twins of its arcs) of distance(tail) + cost using the distances of the
+             * previous round: each node is written by a single thread, so the arc that gave its distance
+             * (its parent arc) is always consistent with it. After each round the parent arcs are walked:
+             * every cycle they form has negative cost, and the cycles of a graph where each node has
+             * at most one parent are vertex-disjoint, so all of them can be cancelled together.
+             * The rounds stop when some cycles are found or when no distance changes (no negative cycle).
+             *
+             * V: number of nodes
+             * E: number of edges
+             * P: number of threads
+             * Time complexity: O(V * (E / P + V)) (worst case)
+             *
+             * @param network the residual network
+             *
+             * @return the arcs of each negative cycle found, in the order they are crossed (empty if there is no negative cycle)
+             *
+             * @throws overflow_error if a distance overflows
+             */
+            static std::vector<std::shared_ptr<std::vector<int>>> NegativeCycles(const std::shared_ptr<data_structures::ResidualNetwork>& network);
+
+        private:
+            /**
+             * Walk the parent arcs of the nodes and collect the cycles they form (see NegativeCycles()).
+             *
+             * @param network    the residual network
+             * @param parent_arc the arc used to reach each node (-1 for the nodes reached from the virtual root)
+             *
+             * @return the arcs of each cycle with negative cost
+             */
+            static std::vector<std::shared_ptr<std::vector<int>>> parentCycles(const std::shared_ptr<data_structures::ResidualNetwork>& network,
+                const std::vector<int>& parent_arc);
+
+            /**
+             * Atomically set distance to the minimum between its value and new_distance.
+             *
+             * @param distance     the distance to update
+             * @param new_distance the candidate distance
+             *
+             * @return true if the distance was decreased, false otherwise
+             */
+            static bool atomicMin(std::atomic<types::accumulator_t>& distance, types::accumulator_t new_distance);
+
+            /**
+             * Build the shortest path tree from the final distances, visiting in breadth-first order
+             * the tight arcs (positive residual capacity and distance(u) + cost(u -> v) = distance(v)).
+             * The parents written during the concurrent relaxations cannot be trusted, and with
+             * zero-cost cycles the tight arcs alone could form cycles, so the tree is built afterwards.
+             *
+             * @param network       the residual network
+             * @param source        the source node
+             * @param distance      the distance of each node
+             * @param reduced_costs true to use the reduced costs, false to use the costs
+             * @param parent        output: the parent of each node
+             * @param parent_arc    output: the arc used to reach each node
+             */
+            static void buildShortestPathTree(const std::shared_ptr<data_structures::ResidualNetwork>& network, int source,
+                const std::vector<types::accumulator_t>& distance, bool reduced_costs, std::vector<int>& parent, std::vector<int>& parent_arc);
+    };
+}
+
+#endif //MINIMUM_COST_FLOWS_PROBLEM_PARALLELSHORTESTPATHALGORITHMS_H
@@ -0,0 +1,386 @@
+#include "BatchRunner.h"
+
+#include "utils/json.hpp"
+#include "utils/GraphUtils.h"
+#include "utils/ThreadPool.h"
+#include "data_structures/snapshot/GraphSnapshot.h"
+#include "data_structures/graph/ReducedGraph.h"
+#include "data_structures/graph/ReorderedGraph.h"
+#include "data_structures/graph/GraphComponents.h"
+#include "algorithms/MaximumFlowAlgorithms.h"
+#include "algorithms/MinimumCostFlowAlgorithms.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+using json = nlohmann::ordered_json;
+
+namespace cli {
+    namespace {
+        using Clock = std::chrono::steady_clock;
+
+        const char* const usage {
+            "Usage: network_flows --algorithm NAME [--source N] [--sink N] [--format FORMAT] [--output FILE]\n"
+            "                     [--paths FILE] [--repeat N] [--threads N] [--reorder ORDER] [--reduce]\n"
+            "                     [--components] FILE...\n"
+            "  --algorithm  edmonds-karp, push-relabel, cycle-cancelling, successive-shortest-path or primal-dual\n"
+            "  --source     the source node (default: 0)\n"
+            "  --sink       the sink node (default: the last node of each graph)\n"
+            "  --format     format of the solutions: json, compact-json, csv or binary (default: json)\n"
+            "  --output     file where the solutions are written (default: the solutions are not written)\n"
+            "  --paths      file where the decompositions of the solutions into paths and cycles are written\n"
+            "               (default: they are not computed)\n"
+            "  --repeat     number of runs of each file (default: 1)\n"
+            "  --threads    number of threads of the parallel algorithms (default: one per core)\n"
+            "  --reorder    renumber the nodes for locality before solving: bfs or rcm (reverse Cuthill-McKee)\n"
+            "  --reduce     solve the graph without the nodes off the source-sink paths, with the chains\n"
+            "               contracted and the parallel edges merged, then expand the solution\n"
+            "  --components solve only the weakly connected component of the source and, for cycle-cancelling,\n"
+            "               the other components with negative costs in parallel\n"
+            "A FILE named shm:NAME is the graph snapshot NAME in shared memory.\n"
+            "One JSON line per run is written on the standard output with the time of each phase in milliseconds.\n"
+        };
+
+        // prefix of the files that are graph snapshots
+        const std::string snapshot_prefix { "shm:" };
+
+        double elapsedMilliseconds(Clock::time_point start) {
+            return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        }
+    }
+
+    bool BatchRunner::IsBatchMode(int argc, char** argv) {
+        for (int i = 1; i < argc; i++) {
+            if (std::string(argv[i]).rfind("--", 0) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    int BatchRunner::Run(int argc, char** argv) {
+        Options options {};
+        try {
+            options = BatchRunner::parseOptions(argc, argv);
+        } catch (std::invalid_argument& e) {
+            std::cerr << "ERROR: " << e.what() << std::endl << usage;
+            return EXIT_FAILURE;
+        }
+        if (options.files.empty()) {
+            std::cout << usage;
+            return EXIT_SUCCESS;
+        }
+
+        std::ofstream output {};
+        if (!options.output.empty()) {
+            output.open(options.output, std::ios::binary);
+            if (!output) {
+                std::cerr << "ERROR: cannot open the output file " << options.output << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+
+        std::ofstream paths {};
+        if (!options.paths.empty()) {
+            paths.open(options.paths, std::ios::binary);
+            if (!paths) {
+                std::cerr << "ERROR: cannot open the paths file " << options.paths << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+
+        if (options.threads > 0) {
+            utils::ThreadPool::SetNumThreads(options.threads);
+        }
+        int num_threads { utils::ThreadPool::GetInstance()->getNumThreads() };
+        bool failed { false };
+
+        for (const auto& file : options.files) {
+            json line {};
+            line["file"] = file;
+            line["algorithm"] = options.algorithm;
+            line["threads"] = num_threads;
+
+            try {
+                auto start = Clock::now();
+                std::shared_ptr<data_structures::Graph> graph {};
+                std::shared_ptr<data_structures::GraphSnapshot> snapshot {};
+                if (file.rfind(snapshot_prefix, 0) == 0) {
+                    snapshot = data_structures::GraphSnapshot::Attach(file.substr(snapshot_prefix.size()));
+                } else {
+                    graph = utils::GraphUtils::CreateGraphFromJSON(file);
+                }
+                double load_ms { elapsedMilliseconds(start) };
+
+                int num_nodes {};
+                std::size_t num_edges {};
+                if (snapshot) {
+                    num_nodes = snapshot->getNumNodes();
+                    num_edges = snapshot->getNumEdges();
+                } else {
+                    num_nodes = graph->getNumNodes();
+                    for (int node = 0; node < num_nodes; node++) {
+                        num_edges += graph->getNodeAdjList(node)->size();
+                    }
+                }
+
+                int source { options.source };
+                int sink { options.sink == -1 ? num_nodes - 1 : options.sink };
+                if (source >= num_nodes || sink >= num_nodes || source == sink) {
+                    throw std::invalid_argument("The source and the sink must be two different nodes of the graph");
+                }
+
+                line["nodes"] = num_nodes;
+                line["edges"] = num_edges;
+
+                // the renumbered graph replaces the graph (and the snapshot) in the next stages and in the runs
+                std::shared_ptr<data_structures::ReorderedGraph> reordered {};
+                if (options.reorder) {
+                    if (!graph) {
+                        graph = snapshot->toGraph();
+                    }
+                    start = Clock::now();
+                    reordered = std::make_shared<data_structures::ReorderedGraph>(graph, source, sink, options.order);
+                    line["reorder_ms"] = elapsedMilliseconds(start);
+                    snapshot.reset();
+                }
+                std::shared_ptr<data_structures::Graph> solved_graph { reordered ? reordered->getGraph() : graph };
+                int solved_source { reordered ? reordered->getSource() : source };
+                int solved_sink { reordered ? reordered->getSink() : sink };
+
+                // the reduced graph replaces the (renumbered) graph in the runs
+                std::shared_ptr<data_structures::ReducedGraph> reduced {};
+                if (options.reduce) {
+                    if (!graph) {
+                        graph = snapshot->toGraph();
+                        solved_graph = graph;
+                    }
+                    start = Clock::now();
+                    reduced = std::make_shared<data_structures::ReducedGraph>(solved_graph, solved_source, solved_sink);
+                    line["reduce_ms"] = elapsedMilliseconds(start);
+                    line["reduced_nodes"] = reduced->getGraph()->getNumNodes();
+                    line["reduced_edges"] = reduced->getNumEdges();
+                    snapshot.reset();
+                    solved_graph = reduced->getGraph();
+                    solved_source = reduced->getSource();
+                    solved_sink = reduced->getSink();
+                }
+
+                // the components of the (renumbered, reduced) graph are solved in place of it
+                std::shared_ptr<data_structures::GraphComponents> components {};
+                if (options.components) {
+                    if (!graph) {
+                        graph = snapshot->toGraph();
+                        solved_graph = graph;
+                    }
+                    start = Clock::now();
+                    components = std::make_shared<data_structures::GraphComponents>(solved_graph, solved_source, solved_sink,
+                        options.algorithm == "cycle-cancelling");
+                    line["components_ms"] = elapsedMilliseconds(start);
+                    line["components"] = components->getNumComponents();
+                    line["circulations"] = components->getCirculationComponents().size();
+                    snapshot.reset();
+                }
+
+                for (int run = 0; run < options.repeat; run++) {
+                    std::shared_ptr<dto::FlowResult> result {};
+                    json residual_ms {};
+
+                    bool maximum_flow { options.algorithm == "edmonds-karp" || options.algorithm == "push-relabel" };
+
+                    // the snapshot is copied into a graph only if the algorithm or the output need it
+                    if (snapshot && !graph && (!maximum_flow || output.is_open() || paths.is_open())) {
+                        graph = snapshot->toGraph();
+                        solved_graph = graph;
+                    }
+
+                    // the maximum flow algorithms run on a residual network built here (or on the snapshot),
+                    // the others build their own
+                    auto solve = [&](const std::shared_ptr<data_structures::Graph>& solve_graph, int solve_source, int solve_sink) {
+                        std::shared_ptr<dto::FlowResult> solve_result {};
+                        if (maximum_flow && snapshot) {
+                            start = Clock::now();
+                            solve_result = options.algorithm == "edmonds-karp"
+                                ? algorithms::MaximumFlowAlgorithms::EdmondsKarp(snapshot, solve_source, solve_sink)
+                                : algorithms::MaximumFlowAlgorithms::ParallelPushRelabel(snapshot, solve_source, solve_sink);
+                        } else if (maximum_flow) {
+                            start = Clock::now();
+                            auto network = std::make_shared<data_structures::ResidualNetwork>(solve_graph);
+                            residual_ms = elapsedMilliseconds(start);
+
+                            start = Clock::now();
+                            solve_result = options.algorithm == "edmonds-karp"
+                                ? algorithms::MaximumFlowAlgorithms::EdmondsKarp(solve_graph, network, solve_source, solve_sink)
+                                : algorithms::MaximumFlowAlgorithms::ParallelPushRelabel(solve_graph, network, solve_source, solve_sink);
+                        } else {
+                            start = Clock::now();
+                            if (options.algorithm == "cycle-cancelling") {
+                                solve_result = algorithms::MinimumCostFlowAlgorithms::CycleCancelling(solve_graph, solve_source, solve_sink);
+                            } else if (options.algorithm == "successive-shortest-path") {
+                                solve_result = algorithms::MinimumCostFlowAlgorithms::SuccessiveShortestPath(solve_graph, solve_source, solve_sink);
+                            } else {
+                                solve_result = algorithms::MinimumCostFlowAlgorithms::PrimalDual(solve_graph, solve_source, solve_sink);
+                            }
+                        }
+                        return solve_result;
+                    };
+
+                    if (components) {
+                        // the flow component runs alone (the parallel algorithms use the whole pool), then the
+                        // circulation components (only for Cycle-Cancelling) run in parallel, each one on a single thread
+                        std::vector<std::shared_ptr<dto::FlowResult>> component_results(components->getNumComponents());
+                        int flow_component { components->getFlowComponent() };
+                        start = Clock::now();
+                        component_results[flow_component] = solve(components->getGraph(flow_component),
+                            components->getSource(), components->getSink());
+                        const auto& circulations = components->getCirculationComponents();
+                        utils::ThreadPool::GetInstance()->parallelFor(static_cast<int>(circulations.size()), 1,
+                            [&](int begin, int end, int) {
+                                for (int i = begin; i < end; i++) {
+                                    component_results[circulations[i]] = algorithms::MinimumCostFlowAlgorithms::MinimumCostCirculation(
+                                        components->getGraph(circulations[i]));
+                                }
+                            });
+
+                        result = components->merge(component_results);
+                        result->setStats(component_results[flow_component]->getStats());
+                    } else {
+                        result = solve(solved_graph, solved_source, solved_sink);
+                    }
+                    double solve_ms { elapsedMilliseconds(start) };
+
+                    // the solution is mapped back through the stages in reverse order
+                    if (reduced || reordered) {
+                        start = Clock::now();
+                        auto stats = result->getStats();
+                        if (reduced) {
+                            result = reduced->expand(result);
+                        }
+                        if (reordered) {
+                            result = reordered->restore(result);
+                        }
+                        result->setStats(stats);
+                        line["expand_ms"] = elapsedMilliseconds(start);
+                    }
+
+                    start = Clock::now();
+                    if (output.is_open()) {
+                        utils::FlowWriter::Write(output, graph, *result->getEdgeFlows(), options.format);
+                        if (options.format != utils::FlowWriter::Format::Binary) {
+                            output << '\n';
+                        }
+                    }
+                    double output_ms { elapsedMilliseconds(start) };
+
+                    if (paths.is_open()) {
+                        start = Clock::now();
+                        utils::FlowWriter::WritePaths(paths, graph, *result->getEdgeFlows(), source, sink, options.format);
+                        if (options.format != utils::FlowWriter::Format::Binary) {
+                            paths << '\n';
+                        }
+                        line["paths_ms"] = elapsedMilliseconds(start);
+                    }
+
+                    line["run"] = run;
+                    line["value"] = result->getFlow();
+                    line["load_ms"] = load_ms;
+                    line["residual_ms"] = residual_ms;
+                    line["solve_ms"] = solve_ms;
+                    line["output_ms"] = output_ms;
+                    if (auto stats = result->getStats()) {
+                        line["stats"] = { { "counters", stats->getCounters() }, { "phase_ms", stats->getPhaseTimes() } };
+                        if (!stats->getPhaseEvents().empty()) {
+                            line["stats"]["events"] = stats->getPhaseEvents();
+                        }
+                    }
+                    std::cout << line.dump() << std::endl;
+                }
+            } catch (std::exception& e) {
+                line["error"] = e.what();
+                std::cout << line.dump() << std::endl;
+                failed = true;
+            }
+        }
+
+        return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+    }
+
+    BatchRunner::Options BatchRunner::parseOptions(int argc, char** argv) {
+        Options options {};
+
+        for (int i = 1; i < argc; i++) {
+            std::string argument { argv[i] };
+            if (argument.rfind("--", 0) != 0) {
+                options.files.push_back(argument);
+                continue;
+            }
+            if (argument == "--help") {
+                options.files.clear();
+                return options;
+            }
+            if (argument == "--reduce") {
+                options.reduce = true;
+                continue;
+            }
+            if (argument == "--components") {
+                options.components = true;
+                continue;
+            }
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("Missing value of the option " + argument);
+            }
+
+            std::string value { argv[++i] };
+            if (argument == "--algorithm") {
+                if (value != "edmonds-karp" && value != "push-relabel" && value != "cycle-cancelling"
+                    && value != "successive-shortest-path" && value != "primal-dual") {
+                    throw std::invalid_argument("Unknown algorithm " + value);
+                }
+                options.algorithm = value;
+            } else if (argument == "--source") {
+                options.source = BatchRunner::parseInteger(argument, value, 0);
+            } else if (argument == "--sink") {
+                options.sink = BatchRunner::parseInteger(argument, value, 0);
+            } else if (argument == "--format") {
+                options.format = utils::FlowWriter::ParseFormat(value);
+            } else if (argument == "--output") {
+                options.output = value;
+            } else if (argument == "--paths") {
+                options.paths = value;
+            } else if (argument == "--repeat") {
+                options.repeat = BatchRunner::parseInteger(argument, value, 1);
+            } else if (argument == "--threads") {
+                options.threads = BatchRunner::parseInteger(argument, value, 1);
+            } else if (argument == "--reorder") {
+                options.reorder = true;
+                options.order = data_structures::ReorderedGraph::ParseOrder(value);
+            } else {
+                throw std::invalid_argument("Unknown option " + argument);
+            }
+        }
+
+        if (!options.files.empty() && options.algorithm.empty()) {
+            throw std::invalid_argument("The option --algorithm is required");
+        }
+
+        return options;
+    }
+
+    int BatchRunner::parseInteger(const std::string& option, const std::string& value, int min) {
+        std::size_t length {};
+        int result {};
+        try {
+            result = std::stoi(value, &length);
+        } catch (std::exception&) {
+            length = 0;
+        }
+
+        if (length == 0 || length != value.size() || result < min) {
+            throw std::invalid_argument("Invalid value " + value + " of the option " + option);
+        }
+        return result;
+    }
+}
\ No newline at end of file
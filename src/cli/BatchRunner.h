@@ -0,0 +1,106 @@
+#ifndef MINIMUM_COST_FLOWS_PROBLEM_BATCHRUNNER_H
+#define MINIMUM_COST_FLOWS_PROBLEM_BATCHRUNNER_H
+
+#include "utils/FlowWriter.h"
+#include "data_structures/graph/ReorderedGraph.h"
+
+#include <string>
+#include <vector>
+
+namespace cli {
+    /**
+     * Non-interactive mode of the command line tool: it solves many graphs in one process
+     * and writes one JSON line per run on the standard output, with the time of each phase in milliseconds:
+     *  - load:     reading the JSON file (once per file)
+     *  - residual: building the residual network (null for the algorithms that build it while solving)
+     *  - solve:    running the algorithm
+     *  - output:   writing the solution (0 if no output file is given)
+     *  - paths:    decomposing the solution into paths and cycles and writing them (only if a paths file is given,
+     *              see utils::FlowWriter::WritePaths())
+     * A file that cannot be solved produces a line with its error and the next files are still solved.
+     * A file named shm:NAME is the graph snapshot NAME in shared memory (see data_structures::GraphSnapshot,
+     * published by the server mode): the load phase attaches to it and the maximum flow algorithms solve it
+     * on the shared arrays, the other algorithms and the output use a private copy of the graph.
+     * With --reorder the nodes are renumbered for locality (see data_structures::ReorderedGraph, once per file)
+     * before the next stages, and the solution is mapped back to the input numbering before the output.
+     * With --reduce every run solves the reduced graph (see data_structures::ReducedGraph, built once per file)
+     * and its solution is expanded to the graph before the output.
+     * With --components the weakly connected components of the (reduced) graph are solved in its place
+     * (see data_structures::GraphComponents, built once per file): the algorithm runs on the component of the
+     * source, for Cycle-Cancelling the minimum cost circulations of the other components with negative costs
+     * are computed in parallel (the other algorithms leave them with the zero flow), then the solutions are merged.
+     *
+     * Usage: network_flows --algorithm NAME [--source N] [--sink N] [--format FORMAT] [--output FILE]
+     *                      [--paths FILE] [--repeat N] [--threads N] [--reorder ORDER] [--reduce]
+     *                      [--components] FILE...
+     */
+    class BatchRunner {
+        public:
+            /**
+             * Check if the arguments select the batch mode (at least one of them is an option "--...").
+             *
+             * @param argc the number of arguments
+             * @param argv the arguments
+             *
+             * @return true if the batch mode is selected, false otherwise
+             */
+            static bool IsBatchMode(int argc, char** argv);
+
+            /**
+             * Parse the arguments and solve every file.
+             *
+             * @param argc the number of arguments
+             * @param argv the arguments
+             *
+             * @return EXIT_SUCCESS if every file was solved, EXIT_FAILURE otherwise
+             */
+            static int Run(int argc, char** argv);
+
+        private:
+            /**
+             * Options of the batch mode.
+             */
+            struct Options {
+                std::string algorithm {};
+                int source { 0 };
+                int sink { -1 };                         // -1: the last node of each graph
+                utils::FlowWriter::Format format { utils::FlowWriter::Format::PrettyJson };
+                std::string output {};                   // empty: the solutions are not written
+                std::string paths {};                    // empty: the paths of the solutions are not written
+                int repeat { 1 };
+                int threads { 0 };                       // 0: one thread per core
+                bool reorder { false };                  // renumber the nodes (see data_structures::ReorderedGraph)
+                data_structures::ReorderedGraph::Order order { data_structures::ReorderedGraph::Order::Bfs };
+                bool reduce { false };                   // solve the reduced graph (see data_structures::ReducedGraph)
+                bool components { false };               // solve the components (see data_structures::GraphComponents)
+                std::vector<std::string> files {};
+            };
+
+            /**
+             * Parse the arguments.
+             *
+             * @param argc the number of arguments
+             * @param argv the arguments
+             *
+             * @return the options
+             *
+             * @throws invalid_argument if an option is unknown, has no value or has an invalid value
+             */
+            static Options parseOptions(int argc, char** argv);
+
+            /**
+             * Parse the integer value of an option.
+             *
+             * @param option the option
+             * @param value  the value
+             * @param min    the minimum valid value
+             *
+             * @return the value
+             *
+             * @throws invalid_argument if the value is not an integer greater or equal than min
+             */
+            static int parseInteger(const std::string& option, const std::string& value, int min);
+    };
+}
+
+#endif //MINIMUM_COST_FLOWS_PROBLEM_BATCHRUNNER_H
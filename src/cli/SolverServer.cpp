@@ -0,0 +1,432 @@
+#include "SolverServer.h"
+
+#include "utils/json.hpp"
+#include "utils/GraphUtils.h"
+#include "utils/ArithmeticUtils.h"
+#include "utils/ThreadPool.h"
+#include "algorithms/MaximumFlowAlgorithms.h"
+#include "algorithms/MinimumCostFlowAlgorithms.h"
+
+#include <chrono>
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <iostream>
+#include <stdexcept>
+
+#include <poll.h>
+#include <unistd.h>
+#include <sys/un.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+
+using json = nlohmann::ordered_json;
+
+namespace cli {
+    namespace {
+        using Clock = std::chrono::steady_clock;
+
+        double elapsedMilliseconds(Clock::time_point start) {
+            return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        }
+
+        int parseNode(const std::string& value) {
+            std::size_t length {};
+            int node {};
+            try {
+                node = std::stoi(value, &length);
+            } catch (std::exception&) {
+                length = 0;
+            }
+            if (length == 0 || length != value.size() || node < 0) {
+                throw std::invalid_argument("Invalid node " + value);
+            }
+            return node;
+        }
+
+        /**
+         * Write the whole buffer, the socket is blocking.
+         */
+        bool writeAll(int fd, const std::string& buffer) {
+            std::size_t written {};
+            while (written < buffer.size()) {
+                ssize_t n { ::write(fd, buffer.data() + written, buffer.size() - written) };
+                if (n < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (n <= 0) {
+                    return false;
+                }
+                written += static_cast<std::size_t>(n);
+            }
+            return true;
+        }
+
+        /**
+         * Remove the socket left at the path by a server that is not running anymore (connecting to it is refused).
+         * A path that is not a socket, or a socket with a server listening on it, is never removed.
+         */
+        bool removeStaleSocket(const sockaddr_un& address, std::string& error) {
+            struct stat status {};
+            if (::lstat(address.sun_path, &status) < 0) {
+                if (errno == ENOENT) {
+                    return true;
+                }
+                error = std::strerror(errno);
+                return false;
+            }
+            if (!S_ISSOCK(status.st_mode)) {
+                error = "the path exists and is not a socket";
+                return false;
+            }
+
+            int probe { ::socket(AF_UNIX, SOCK_STREAM, 0) };
+            if (probe < 0) {
+                error = std::strerror(errno);
+                return false;
+            }
+            int connected { ::connect(probe, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) };
+            int connect_error { errno };
+            ::close(probe);
+            if (connected == 0) {
+                error = "another server is listening on it";
+                return false;
+            }
+            if (connect_error != ECONNREFUSED) {
+                error = std::strerror(connect_error);
+                return false;
+            }
+
+            if (::unlink(address.sun_path) < 0 && errno != ENOENT) {
+                error = std::strerror(errno);
+                return false;
+            }
+            return true;
+        }
+    }
+
+    bool SolverServer::IsServerMode(int argc, char** argv) {
+        for (int i = 1; i < argc; i++) {
+            if (std::string(argv[i]) == "--serve") {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    int SolverServer::Run(int argc, char** argv) {
+        std::string path {};
+        int threads {};
+        for (int i = 1; i < argc; i++) {
+            std::string argument { argv[i] };
+            if (i + 1 >= argc || (argument != "--serve" && argument != "--threads")) {
+                std::cerr << "ERROR: invalid argument " << argument << std::endl
+                          << "Usage: network_flows --serve SOCKET_PATH [--threads N]" << std::endl;
+                return EXIT_FAILURE;
+            }
+
+            std::string value { argv[++i] };
+            if (argument == "--serve") {
+                path = value;
+            } else {
+                try {
+                    threads = parseNode(value);
+                } catch (std::invalid_argument&) {
+                    threads = 0;
+                }
+                if (threads <= 0) {
+                    std::cerr << "ERROR: invalid number of threads " << value << std::endl;
+                    return EXIT_FAILURE;
+                }
+            }
+        }
+        if (threads > 0) {
+            utils::ThreadPool::SetNumThreads(threads);
+        }
+
+        sockaddr_un address {};
+        address.sun_family = AF_UNIX;
+        if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+            std::cerr << "ERROR: invalid socket path " << path << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+        std::string error {};
+        if (!removeStaleSocket(address, error)) {
+            std::cerr << "ERROR: cannot listen on " << path << ": " << error << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        // the socket created by bind() is identified by its inode, it is removed at the end only if it is still there
+        int server { ::socket(AF_UNIX, SOCK_STREAM, 0) };
+        struct stat bound {};
+        if (server < 0 || ::bind(server, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0
+            || ::lstat(path.c_str(), &bound) < 0 || ::listen(server, SOMAXCONN) < 0) {
+            std::cerr << "ERROR: cannot listen on " << path << ": " << std::strerror(errno) << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        // a client closing its socket must not kill the server
+        std::signal(SIGPIPE, SIG_IGN);
+        std::cout << "Listening on " << path << std::endl;
+
+        Cache cache {};
+        std::vector<pollfd> fds { { server, POLLIN, 0 } };
+        std::map<int, std::string> pending {};                 // received bytes of each client not yet processed
+        std::vector<char> buffer(1 << 16);
+        bool shutdown { false };
+
+        while (!shutdown) {
+            if (::poll(fds.data(), fds.size(), -1) < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                std::cerr << "ERROR: " << std::strerror(errno) << std::endl;
+                break;
+            }
+
+            std::vector<pollfd> next_fds { fds.front() };
+            if (fds.front().revents & POLLIN) {
+                int client { ::accept(server, nullptr, nullptr) };
+                if (client >= 0) {
+                    next_fds.push_back({ client, POLLIN, 0 });
+                }
+            }
+
+            for (std::size_t i = 1; i < fds.size(); i++) {
+                int client { fds[i].fd };
+                bool open { true };
+
+                if (fds[i].revents & (POLLIN | POLLHUP | POLLERR)) {
+                    ssize_t n { ::read(client, buffer.data(), buffer.size()) };
+                    if (n <= 0 && !(n < 0 && errno == EINTR)) {
+                        open = false;
+                    } else if (n > 0) {
+                        // answer every complete request received, the responses are sent with a single write
+                        auto& input = pending[client];
+                        input.append(buffer.data(), static_cast<std::size_t>(n));
+
+                        std::string responses {};
+                        std::size_t begin {};
+                        std::size_t end {};
+                        while (!shutdown && (end = input.find('\n', begin)) != std::string::npos) {
+                            responses += SolverServer::handleRequest(input.substr(begin, end - begin), cache, shutdown);
+                            responses += '\n';
+                            begin = end + 1;
+                        }
+                        input.erase(0, begin);
+                        open = writeAll(client, responses);
+                    }
+                }
+
+                if (open) {
+                    next_fds.push_back(fds[i]);
+                } else {
+                    pending.erase(client);
+                    ::close(client);
+                }
+            }
+            fds.swap(next_fds);
+        }
+
+        for (auto& fd : fds) {
+            ::close(fd.fd);
+        }
+        struct stat status {};
+        if (::lstat(path.c_str(), &status) == 0 && S_ISSOCK(status.st_mode)
+            && status.st_dev == bound.st_dev && status.st_ino == bound.st_ino) {
+            ::unlink(path.c_str());
+        }
+
+        return shutdown ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    std::string SolverServer::handleRequest(const std::string& request, Cache& cache, bool& shutdown) {
+        std::istringstream stream { request };
+        std::vector<std::string> tokens {};
+        for (std::string token; stream >> token;) {
+            tokens.push_back(token);
+        }
+
+        json response {};
+        try {
+            if (tokens.empty()) {
+                throw std::invalid_argument("Empty request");
+            }
+            const std::string& command { tokens.front() };
+
+            if (command == "LOAD" && tokens.size() == 3) {
+                auto start = Clock::now();
+                auto graph = utils::GraphUtils::CreateGraphFromJSON(tokens[2]);
+                auto network = std::make_shared<data_structures::ResidualNetwork>(graph);
+
+                std::size_t num_edges {};
+                for (int node = 0; node < graph->getNumNodes(); node++) {
+                    num_edges += graph->getNodeAdjList(node)->size();
+                }
+                cache[tokens[1]] = CachedGraph { graph, network, num_edges, nullptr };
+
+                response["ok"] = true;
+                response["name"] = tokens[1];
+                response["nodes"] = graph->getNumNodes();
+                response["edges"] = num_edges;
+                response["load_ms"] = elapsedMilliseconds(start);
+            } else if (command == "PUBLISH" && tokens.size() == 3) {
+                auto it = cache.find(tokens[1]);
+                if (it == cache.end() || !it->second.graph) {
+                    throw std::invalid_argument("No loaded graph named " + tokens[1]);
+                }
+
+                auto start = Clock::now();
+                std::size_t size { data_structures::GraphSnapshot::Publish(tokens[2], it->second.graph, it->second.network) };
+
+                response["ok"] = true;
+                response["snapshot"] = tokens[2];
+                response["bytes"] = size;
+                response["publish_ms"] = elapsedMilliseconds(start);
+            } else if (command == "ATTACH" && tokens.size() == 3) {
+                auto start = Clock::now();
+                auto snapshot = data_structures::GraphSnapshot::Attach(tokens[2]);
+                cache[tokens[1]] = CachedGraph { nullptr, nullptr, static_cast<std::size_t>(snapshot->getNumEdges()), snapshot };
+
+                response["ok"] = true;
+                response["name"] = tokens[1];
+                response["nodes"] = snapshot->getNumNodes();
+                response["edges"] = snapshot->getNumEdges();
+                response["load_ms"] = elapsedMilliseconds(start);
+            } else if (command == "UNLINK" && tokens.size() == 2) {
+                data_structures::GraphSnapshot::Unlink(tokens[1]);
+                response["ok"] = true;
+            } else if (command == "DROP" && tokens.size() == 2) {
+                if (cache.erase(tokens[1]) == 0) {
+                    throw std::invalid_argument("No graph named " + tokens[1]);
+                }
+                response["ok"] = true;
+            } else if (command == "LIST" && tokens.size() == 1) {
+                response["ok"] = true;
+                response["graphs"] = json::array();
+                for (const auto& [name, cached] : cache) {
+                    int num_nodes { cached.snapshot ? cached.snapshot->getNumNodes() : cached.graph->getNumNodes() };
+                    response["graphs"].push_back({ { "name", name }, { "nodes", num_nodes }, { "edges", cached.num_edges },
+                        { "snapshot", cached.snapshot != nullptr } });
+                }
+            } else if (command == "SOLVE" && tokens.size() >= 3) {
+                return SolverServer::solve(tokens, cache);
+            } else if (command == "SHUTDOWN" && tokens.size() == 1) {
+                shutdown = true;
+                response["ok"] = true;
+            } else {
+                throw std::invalid_argument("Invalid request: " + request);
+            }
+        } catch (std::exception& e) {
+            response = json {};
+            response["ok"] = false;
+            response["error"] = e.what();
+        }
+
+        return response.dump();
+    }
+
+    std::string SolverServer::solve(const std::vector<std::string>& tokens, const Cache& cache) {
+        auto it = cache.find(tokens[1]);
+        if (it == cache.end()) {
+            throw std::invalid_argument("No graph named " + tokens[1]);
+        }
+        const auto& cached = it->second;
+        const std::string& algorithm { tokens[2] };
+        auto graph = cached.graph;
+        int num_nodes { cached.snapshot ? cached.snapshot->getNumNodes() : graph->getNumNodes() };
+
+        int source { 0 };
+        int sink { num_nodes - 1 };
+        bool flows { false };
+        std::vector<data_structures::Edge> overrides {};
+        for (std::size_t i = 3; i < tokens.size(); i++) {
+            const std::string& token { tokens[i] };
+            if (token.rfind("source=", 0) == 0) {
+                source = parseNode(token.substr(7));
+            } else if (token.rfind("sink=", 0) == 0) {
+                sink = parseNode(token.substr(5));
+            } else if (token.rfind("edge=", 0) == 0) {
+                // edge=U:V:CAPACITY
+                std::istringstream edge { token.substr(5) };
+                long long u {};
+                long long v {};
+                long long capacity {};
+                char first {};
+                char second {};
+                if (!(edge >> u >> first >> v >> second >> capacity) || first != ':' || second != ':' || !edge.eof()) {
+                    throw std::invalid_argument("Invalid edge " + token);
+                }
+                overrides.emplace_back(static_cast<int>(u), static_cast<int>(v),
+                    utils::ArithmeticUtils::CheckedCast<types::capacity_t>(capacity), 0);
+            } else if (token == "flows") {
+                flows = true;
+            } else {
+                throw std::invalid_argument("Invalid token " + token);
+            }
+        }
+        if (source >= num_nodes || sink >= num_nodes || source == sink) {
+            throw std::invalid_argument("The source and the sink must be two different nodes of the graph");
+        }
+
+        bool maximum_flow { algorithm == "edmonds-karp" || algorithm == "push-relabel" };
+        bool on_snapshot { cached.snapshot && maximum_flow && overrides.empty() };
+
+        // the other queries on a snapshot run on a private copy of its graph
+        if (cached.snapshot && !on_snapshot) {
+            graph = cached.snapshot->toGraph();
+        }
+
+        // the overrides are applied to a copy, the cached graph is never changed
+        if (!overrides.empty()) {
+            graph = std::make_shared<data_structures::Graph>(graph);
+            for (const auto& e : overrides) {
+                graph->setEdgeCapacity(e.getSource(), e.getSink(), e.getCapacity());
+            }
+        }
+
+        auto start = Clock::now();
+        std::shared_ptr<dto::FlowResult> result {};
+        if (on_snapshot) {
+            result = algorithm == "edmonds-karp"
+                ? algorithms::MaximumFlowAlgorithms::EdmondsKarp(cached.snapshot, source, sink)
+                : algorithms::MaximumFlowAlgorithms::ParallelPushRelabel(cached.snapshot, source, sink);
+        } else if (maximum_flow) {
+            // the cached residual network is copied, it is built again only if the capacities changed
+            auto network = overrides.empty() && cached.network
+                ? std::make_shared<data_structures::ResidualNetwork>(*cached.network)
+                : std::make_shared<data_structures::ResidualNetwork>(graph);
+
+            result = algorithm == "edmonds-karp"
+                ? algorithms::MaximumFlowAlgorithms::EdmondsKarp(graph, network, source, sink)
+                : algorithms::MaximumFlowAlgorithms::ParallelPushRelabel(graph, network, source, sink);
+        } else if (algorithm == "cycle-cancelling") {
+            result = algorithms::MinimumCostFlowAlgorithms::CycleCancelling(graph, source, sink);
+        } else if (algorithm == "successive-shortest-path") {
+            result = algorithms::MinimumCostFlowAlgorithms::SuccessiveShortestPath(graph, source, sink);
+        } else if (algorithm == "primal-dual") {
+            result = algorithms::MinimumCostFlowAlgorithms::PrimalDual(graph, source, sink);
+        } else {
+            throw std::invalid_argument("Unknown algorithm " + algorithm);
+        }
+
+        json response {};
+        response["ok"] = true;
+        response["value"] = result->getFlow();
+        response["solve_ms"] = elapsedMilliseconds(start);
+        if (auto stats = result->getStats()) {
+            response["stats"] = { { "counters", stats->getCounters() }, { "phase_ms", stats->getPhaseTimes() } };
+            if (!stats->getPhaseEvents().empty()) {
+                response["stats"]["events"] = stats->getPhaseEvents();
+            }
+        }
+        if (flows) {
+            response["flows"] = *result->getEdgeFlows();
+        }
+        return response.dump();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,101 @@
+#ifndef MINIMUM_COST_FLOWS_PROBLEM_SOLVERSERVER_H
+#define MINIMUM_COST_FLOWS_PROBLEM_SOLVERSERVER_H
+
+#include "data_structures/graph/Graph.h"
+#include "data_structures/graph/ResidualNetwork.h"
+#include "data_structures/snapshot/GraphSnapshot.h"
+
+#include <map>
+#include <string>
+#include <vector>
+#include <memory>
+
+namespace cli {
+    /**
+     * Server mode of the command line tool: the graphs are loaded once into a named in-memory cache
+     * and the queries are answered over a Unix domain socket, so a query pays neither the process start
+     * nor the parsing of the JSON file. Each cached graph keeps its residual network, the maximum flow
+     * queries start from a copy of it instead of building it again.
+     *
+     * The protocol is line based: each request is a line of space separated tokens and gets a JSON line as response
+     * ({"ok": true, ...} or {"ok": false, "error": "..."}). A client can send many requests at once (batching),
+     * the responses are sent back together and in the same order.
+     *  - LOAD name path: load (or replace) the graph of the JSON file
+     *  - DROP name: remove the graph from the cache
+     *  - LIST: the cached graphs
+     *  - SOLVE name algorithm [source=N] [sink=N] [edge=U:V:CAPACITY]... [flows]: solve the graph with the algorithm
+     *    (see BatchRunner), the edge tokens change the capacity of existing edges for this query only,
+     *    flows adds the flow of each edge to the response
+     *  - PUBLISH name snapshot: publish the loaded graph as a snapshot in shared memory (see data_structures::GraphSnapshot)
+     *  - ATTACH name snapshot: cache a snapshot published by another process, the maximum flow queries without
+     *    edge tokens solve it on the shared arrays, the other queries on a private copy of the graph
+     *  - UNLINK snapshot: remove a snapshot from the shared memory (the attached processes keep it)
+     *  - SHUTDOWN: stop the server
+     * The requests are served one at a time, so every query can use all the threads of the pool.
+     * Many servers on the same host can share a graph: one of them loads and publishes it, the others attach to it.
+     * The server replaces only a socket left by a server that stopped: it does not start if the path is another file
+     * or a running server listens on it.
+     *
+     * Usage: network_flows --serve SOCKET_PATH [--threads N]
+     */
+    class SolverServer {
+        public:
+            /**
+             * Check if the arguments select the server mode (the option --serve is given).
+             *
+             * @param argc the number of arguments
+             * @param argv the arguments
+             *
+             * @return true if the server mode is selected, false otherwise
+             */
+            static bool IsServerMode(int argc, char** argv);
+
+            /**
+             * Parse the arguments and serve the requests until SHUTDOWN.
+             *
+             * @param argc the number of arguments
+             * @param argv the arguments
+             *
+             * @return EXIT_SUCCESS if the server stopped after SHUTDOWN, EXIT_FAILURE otherwise
+             */
+            static int Run(int argc, char** argv);
+
+        private:
+            /**
+             * A graph of the cache.
+             */
+            struct CachedGraph {
+                std::shared_ptr<data_structures::Graph> graph;               // nullptr for an attached snapshot
+                std::shared_ptr<data_structures::ResidualNetwork> network;   // residual network of the graph, without flow
+                std::size_t num_edges;
+                std::shared_ptr<data_structures::GraphSnapshot> snapshot;    // the attached snapshot (nullptr for a loaded graph)
+            };
+
+            using Cache = std::map<std::string, CachedGraph>;
+
+            /**
+             * Answer a request.
+             *
+             * @param request  the request line
+             * @param cache    the graph cache
+             * @param shutdown output: set to true if the request is SHUTDOWN
+             *
+             * @return the response line
+             */
+            static std::string handleRequest(const std::string& request, Cache& cache, bool& shutdown);
+
+            /**
+             * Answer a SOLVE request.
+             *
+             * @param tokens the tokens of the request
+             * @param cache  the graph cache
+             *
+             * @return the response line
+             *
+             * @throws invalid_argument if the request is not valid, and the exceptions of the algorithm
+             */
+            static std::string solve(const std::vector<std::string>& tokens, const Cache& cache);
+    };
+}
+
+#endif //MINIMUM_COST_FLOWS_PROBLEM_SOLVERSERVER_H
@@ -1,12 +1,39 @@
 #ifndef MINIMUM_COST_FLOWS_PROBLEM_CONSTS_H
 #define MINIMUM_COST_FLOWS_PROBLEM_CONSTS_H
 
+#include "types/Types.h"
+
+#include <limits>
+
 namespace consts {
     // used to represent the source node
     inline constexpr int source { 0 };
     
     // used to represent the source node parent
     inline constexpr int source_parent { -1 };
+
+    // used to represent the distance of a node not reachable from the source
+    inline constexpr types::accumulator_t infinite_distance { std::numeric_limits<types::accumulator_t>::max() };
+
+    // minimum number of arcs of a residual network to run the parallel algorithms
+    inline constexpr int parallel_min_arcs { 1 << 15 };
+
+    // number of nodes processed by a thread at a time in the parallel algorithms
+    inline constexpr int parallel_grain { 64 };
+
+    // Successive Shortest Path sends a blocking flow on the arcs with zero reduced cost (all the shortest paths)
+    // after each shortest path computation, instead of the flow of a single path
+    inline constexpr bool ssp_blocking_flow { true };
+
+    // number of relabels, as a multiple of the number of nodes, between two global relabels of the push-relabel algorithm
+    inline constexpr int global_relabel_frequency { 1 };
+
+    // the direction-optimizing BFS switches to bottom-up steps when the arcs of the frontier
+    // are more than the unexplored arcs / bfs_alpha
+    inline constexpr int bfs_alpha { 14 };
+
+    // the direction-optimizing BFS switches back to top-down steps when the frontier has less than V / bfs_beta nodes
+    inline constexpr int bfs_beta { 24 };
 }
 
 #endif //MINIMUM_COST_FLOWS_PROBLEM_CONSTS_H
@@ -1,7 +1,7 @@
 #include "Edge.h"
 
 namespace data_structures {
-    Edge::Edge(const int source, const int sink, const int capacity, const int cost) :
+    Edge::Edge(const int source, const int sink, const types::capacity_t capacity, const types::cost_t cost) :
             source(source),
             sink(sink),
             capacity(capacity),
@@ -16,19 +16,19 @@ namespace data_structures {
         return this->sink;
     }
 
-    int Edge::getCapacity() const {
+    types::capacity_t Edge::getCapacity() const {
         return this->capacity;
     }
 
-    int Edge::getCost() const {
+    types::cost_t Edge::getCost() const {
         return this->cost;
     }
 
-    void Edge::setCapacity(int new_capacity) {
+    void Edge::setCapacity(types::capacity_t new_capacity) {
         this->capacity = new_capacity;
     }
 
-    void Edge::setCost(int new_cost) {
+    void Edge::setCost(types::cost_t new_cost) {
         this->cost = new_cost;
     }
 
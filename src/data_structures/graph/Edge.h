@@ -1,12 +1,14 @@
 #ifndef MINIMUM_COST_FLOWS_PROBLEM_EDGE_H
 #define MINIMUM_COST_FLOWS_PROBLEM_EDGE_H
 
+#include "types/Types.h"
+
 #include <string>
 
 namespace data_structures {
     /**
      * Class representing an edge of the graph.
-     * All the value are integer.
+     * All the value are integer (see types/Types.h for the capacity and cost types).
      * Each edge has:
      *  - source (the start node)
      *  - sink (the end node)
@@ -23,7 +25,7 @@ namespace data_structures {
          * @param capacity The capacity of the edge
          * @param cost     The cost of the edge
          */
-        Edge(int source, int sink, int capacity, int cost);
+        Edge(int source, int sink, types::capacity_t capacity, types::cost_t cost);
 
         /**
          * Get the source of the edge.
@@ -44,28 +46,28 @@ namespace data_structures {
          *
          * @return the capacity of the edge
          */
-        [[nodiscard]] int getCapacity() const;
+        [[nodiscard]] types::capacity_t getCapacity() const;
 
         /**
          * Get the cost of the edge.
          *
          * @return the cost of the edge
          */
-        [[nodiscard]] int getCost() const;
+        [[nodiscard]] types::cost_t getCost() const;
 
         /**
          * Set the capacity of the edge.
          *
          * @param new_capacity the new capacity of the edge
          */
-        void setCapacity(int new_capacity);
+        void setCapacity(types::capacity_t new_capacity);
 
         /**
          * Set the cost of the edge.
          *
          * @param new_weight the new cost of the edge
          */
-        void setCost(int new_cost);
+        void setCost(types::cost_t new_cost);
 
         /**
          * Print the edge in JSON format.
@@ -93,8 +95,8 @@ namespace data_structures {
     private:
         int source; // source of the edge
         int sink; // sink of the edge
-        int capacity; // capacity of the edge
-        int cost; // cost of the edge
+        types::capacity_t capacity; // capacity of the edge
+        types::cost_t cost; // cost of the edge
     };
 }
 
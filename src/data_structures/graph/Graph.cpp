@@ -1,9 +1,10 @@
 #include "Graph.h"
 
-#include <stdexcept>
-#include <utils/json.hpp>
+#include "utils/FlowWriter.h"
 
-using json = nlohmann::ordered_json;
+#include <sstream>
+#include <algorithm>
+#include <stdexcept>
 
 namespace data_structures {
 
@@ -14,8 +15,6 @@ namespace data_structures {
         for (int node = 0; node < num_nodes; node++) {
             this->g->insert({node, std::make_shared<std::vector<Edge>>()});
         }
-
-        this->artificial_nodes = std::make_shared<std::map<int, Edge>>();
     }
 
     Graph::Graph(const std::shared_ptr<Graph> other) {
@@ -35,11 +34,6 @@ namespace data_structures {
                 this->g->at(node)->push_back(edge);
             }
         }
-
-        this->artificial_nodes = std::make_shared<std::map<int, Edge>>();
-        for (auto it : *other->artificial_nodes) {
-            this->artificial_nodes->insert({it.first, it.second});
-        }
     }
 
     int Graph::getStartingNumNodes() const {
@@ -82,7 +76,7 @@ namespace data_structures {
         throw std::invalid_argument(data_structures::Graph::getNoEdgeString(source, sink));
     }
 
-    void Graph::setEdgeCapacity(int source, int sink, int capacity) {
+    void Graph::setEdgeCapacity(int source, int sink, types::capacity_t capacity) {
         Graph::checkNodeExistence(source);
         Graph::checkNodeExistence(sink);
         Graph::checkNegativeCapacity(capacity);
@@ -97,7 +91,7 @@ namespace data_structures {
         throw std::invalid_argument(data_structures::Graph::getNoEdgeString(source, sink));
     }
 
-    void Graph::setEdgeCost(int source, int sink, int cost) {
+    void Graph::setEdgeCost(int source, int sink, types::cost_t cost) {
         Graph::checkNodeExistence(source);
         Graph::checkNodeExistence(sink);
 
@@ -142,7 +136,7 @@ namespace data_structures {
         this->g->at(source)->push_back(e);
     }
 
-    void Graph::addEdge(int source, int sink, int capacity, int cost) {
+    void Graph::addEdge(int source, int sink, types::capacity_t capacity, types::cost_t cost) {
         auto edge = data_structures::Edge(source, sink, capacity, cost);
         this->addEdge(edge);
     }
@@ -165,34 +159,13 @@ namespace data_structures {
         throw std::invalid_argument(data_structures::Graph::getNoEdgeString(source, sink));
     }
 
-    std::shared_ptr<std::map<int, Edge>> Graph::getArtificialNodesMap() const {
-        return this->artificial_nodes;
-    }
-
-    void Graph::addArtificialNodes(int node, Edge edge) {
-        this->artificial_nodes->insert({node, edge});
-    }
-
     std::string Graph::toString() const {
-        std::string s = "{";
-        s += "\"Edges\": [";
-
-        // iterate over the adj list 
-        for (auto & it : *this->g) {
-            auto adj_list = it.second; // adj list of the source node
-            for (auto e : *adj_list) {
-                s += e.toString();
-                s += ", ";
-            }
-        }
-
-        // remove the last comma
-        s = s.substr(0, s.size() - 2);
-        s += "]}";
-        
-        // beautify the json
-        s = json::parse(s).dump(4);
-        return s;
+        // every edge with its capacity, also the edges with capacity 0
+        // (the copy shares the adjacency lists, the edges are not copied)
+        auto graph = std::make_shared<Graph>(*this);
+        std::ostringstream out;
+        utils::FlowWriter::WriteGraph(out, graph, utils::FlowWriter::Format::PrettyJson);
+        return out.str();
     }
 
     bool Graph::operator==(const data_structures::Graph &other) const {
@@ -237,7 +210,7 @@ namespace data_structures {
         }
     }
 
-    void Graph::checkNegativeCapacity(int capacity) {
+    void Graph::checkNegativeCapacity(types::capacity_t capacity) {
         if (capacity < 0) {
             throw std::invalid_argument("capacity must be positive");
         }
@@ -101,7 +101,7 @@ namespace data_structures {
              * @throws invalid_argument if the edge does not exist
              * @throws invalid_argument if the capacity is negative
              */
-            void setEdgeCapacity(int source, int sink, int capacity);
+            void setEdgeCapacity(int source, int sink, types::capacity_t capacity);
 
             /**
              * Set the cost of the edge between the nodes u and v.
@@ -114,7 +114,7 @@ namespace data_structures {
              * @throws invalid_argument if the edge does not exist
              * @throws invalid_argument if the weight is negative
              */
-            void setEdgeCost(int source, int sink, int cost);
+            void setEdgeCost(int source, int sink, types::cost_t cost);
 
             /**
             * Add the direct edge e to the graph.
@@ -140,7 +140,7 @@ namespace data_structures {
              * @throws invalid_argument if the edge already exists
              * @throws invalid_argument if the capacity is negative
              */
-            void addEdge(int source, int sink, int capacity, int cost);
+            void addEdge(int source, int sink, types::capacity_t capacity, types::cost_t cost);
 
             /**
              * Remove the direct edge source -> sink from the graph.
@@ -153,29 +153,6 @@ namespace data_structures {
              */
             void removeEdge(int source, int sink);
 
-            /**
-             * Get the artificial node map.
-             * Artificial nodes are nodes that are added to the graph to handle anti-parallel edges.
-             * The flow algorithms use the residual graph (with backward edges), so it is necessary to remove
-             * anti-parallel edges and to do so it is added, for each anti-parallel edge, a node (artificial node)
-             * in the middle of the edge with the smaller source id.
-             * The map has as:
-             *   - Key:   the id of the artificial node
-             *   - Value: the edge that the artificial node represents
-             * 
-             * @return the artificial node map
-             */
-            std::shared_ptr<std::map<int, Edge>> getArtificialNodesMap() const;
-
-            /**
-             * Add the artificial node to the graph.
-             * For an explanation of what an artificial node is, see the documentation of the method getArtificialNodesMap().
-             * 
-             * @param node the id of the artificial node
-             * @param edge the edge that the artificial node represents
-             */
-            void addArtificialNodes(int node, Edge edge);
-
             /**
             * Print the graph in JSON format.
             */
@@ -234,18 +211,13 @@ namespace data_structures {
              * 
              * @throws invalid_argument if the capacity is negative
              */
-            static void checkNegativeCapacity(int capacity);
+            static void checkNegativeCapacity(types::capacity_t capacity);
 
             // the starting number of nodes of the graph
             int num_nodes;
 
             // graph represented using map of adjacent list
             std::shared_ptr<std::map<int, std::shared_ptr<std::vector<Edge>>>> g;
-
-            // map of artificial nodes
-            // artificial nodes are used for anti-parallel edges
-            // Key: artificial node / Value: the substitute edge
-            std::shared_ptr<std::map<int, Edge>> artificial_nodes;
     };
 }
 #endif //MINIMUM_COST_FLOWS_PROBLEM_GRAPH_H
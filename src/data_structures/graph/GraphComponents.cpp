@@ -0,0 +1,165 @@
+#include "GraphComponents.h"
+
+#include "utils/GraphUtils.h"
+#include "utils/ArithmeticUtils.h"
+
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+
+namespace data_structures {
+    GraphComponents::GraphComponents(const std::shared_ptr<Graph>& graph, int source, int sink, bool circulations) :
+        graph(graph), source(source), sink(sink), flow_component(-1), flow_sink(-1) {
+
+        int num_nodes { graph->getNumNodes() };
+        if (source < 0 || sink < 0 || source >= num_nodes || sink >= num_nodes || source == sink) {
+            throw std::invalid_argument("The source and the sink must be two different nodes of the graph");
+        }
+
+        // union-find of the nodes joined by an edge (union by size, path halving)
+        std::vector<int> parent(num_nodes);
+        std::vector<int> size(num_nodes, 1);
+        std::iota(parent.begin(), parent.end(), 0);
+        auto find = [&parent](int node) {
+            while (parent[node] != node) {
+                parent[node] = parent[parent[node]];
+                node = parent[node];
+            }
+            return node;
+        };
+        for (int node = 0; node < num_nodes; node++) {
+            for (const auto& e : *graph->getNodeAdjList(node)) {
+                int u { find(node) };
+                int v { find(e.getSink()) };
+                if (u == v) {
+                    continue;
+                }
+                if (size[u] < size[v]) {
+                    std::swap(u, v);
+                }
+                parent[v] = u;
+                size[u] += size[v];
+            }
+        }
+
+        // number the components in the order of their first node, the nodes of each one in the same order
+        std::vector<int> root_component(num_nodes, -1);
+        this->node_component.resize(num_nodes);
+        this->node_map.resize(num_nodes);
+        for (int node = 0; node < num_nodes; node++) {
+            int root { find(node) };
+            if (root_component[root] == -1) {
+                root_component[root] = static_cast<int>(this->component_nodes.size());
+                this->component_nodes.emplace_back();
+            }
+            int component { root_component[root] };
+            this->node_component[node] = component;
+            this->node_map[node] = static_cast<int>(this->component_nodes[component].size());
+            this->component_nodes[component].push_back(node);
+        }
+
+        // the edges and the negative costs of each component
+        int num_components { this->getNumComponents() };
+        std::vector<std::size_t> component_edges(num_components, 0);
+        std::vector<bool> negative_costs(num_components, false);
+        for (int node = 0; node < num_nodes; node++) {
+            int component { this->node_component[node] };
+            for (const auto& e : *graph->getNodeAdjList(node)) {
+                component_edges[component]++;
+                negative_costs[component] = negative_costs[component] || e.getCost() < 0;
+            }
+        }
+
+        // a sink in another component is the node after the nodes of the flow component
+        this->flow_component = this->node_component[source];
+        this->flow_sink = this->node_component[sink] == this->flow_component
+            ? this->node_map[sink]
+            : static_cast<int>(this->component_nodes[this->flow_component].size());
+        for (int component = 0; circulations && component < num_components; component++) {
+            if (component != this->flow_component && negative_costs[component]) {
+                this->circulation_components.push_back(component);
+            }
+        }
+        std::stable_sort(this->circulation_components.begin(), this->circulation_components.end(),
+            [&component_edges](int a, int b) { return component_edges[a] > component_edges[b]; });
+
+        // build only the graphs that are solved
+        this->component_graphs.resize(num_components);
+        std::vector<int> solved_components { this->circulation_components };
+        solved_components.push_back(this->flow_component);
+        for (int component : solved_components) {
+            const auto& nodes = this->component_nodes[component];
+            int num_component_nodes { static_cast<int>(nodes.size()) };
+            if (component == this->flow_component) {
+                num_component_nodes = std::max(num_component_nodes, this->flow_sink + 1);
+            }
+            auto component_graph = std::make_shared<Graph>(num_component_nodes);
+            for (int node : nodes) {
+                for (const auto& e : *graph->getNodeAdjList(node)) {
+                    component_graph->addEdge(this->node_map[node], this->node_map[e.getSink()], e.getCapacity(), e.getCost());
+                }
+            }
+            this->component_graphs[component] = component_graph;
+        }
+    }
+
+    std::shared_ptr<dto::FlowResult> GraphComponents::merge(const std::vector<std::shared_ptr<dto::FlowResult>>& results) const {
+        int num_nodes { this->graph->getNumNodes() };
+
+        // the first edge of each node in the order of the graph
+        std::vector<std::size_t> first_edge(num_nodes + 1, 0);
+        for (int node = 0; node < num_nodes; node++) {
+            first_edge[node + 1] = first_edge[node] + this->graph->getNodeAdjList(node)->size();
+        }
+
+        // the edges of a component are the edges of its nodes in the same order
+        auto edge_flows = std::make_shared<std::vector<types::capacity_t>>(first_edge[num_nodes], 0);
+        types::accumulator_t value {};
+        for (int component = 0; component < this->getNumComponents(); component++) {
+            const auto& result = results.at(component);
+            if (!result) {
+                continue;
+            }
+
+            const auto& component_flows = *result->getEdgeFlows();
+            std::size_t component_edge {};
+            for (int node : this->component_nodes[component]) {
+                for (std::size_t edge = first_edge[node]; edge < first_edge[node + 1]; edge++) {
+                    (*edge_flows)[edge] = component_flows[component_edge++];
+                }
+            }
+            value = utils::ArithmeticUtils::CheckedAdd(value, result->getFlow());
+        }
+
+        auto optimal_graph = utils::GraphUtils::GetOptimalGraph(this->graph, *edge_flows);
+
+        std::shared_ptr<dto::MinCut> min_cut {};
+        if (results.at(this->flow_component)) {
+            min_cut = results.at(this->flow_component)->getMinCut();
+        }
+        if (!min_cut) {
+            return std::make_shared<dto::FlowResult>(optimal_graph, edge_flows, value);
+        }
+
+        // the nodes of the flow component keep their side, the others are on the sink side
+        auto source_side = std::make_shared<std::vector<bool>>(num_nodes, false);
+        for (int node : this->component_nodes[this->flow_component]) {
+            (*source_side)[node] = min_cut->getSourceSide()->at(this->node_map[node]);
+        }
+
+        auto cut_edges = std::make_shared<std::vector<Edge>>();
+        for (int node = 0; node < num_nodes; node++) {
+            if (!(*source_side)[node]) {
+                continue;
+            }
+            for (const auto& e : *this->graph->getNodeAdjList(node)) {
+                if (e.getCapacity() > 0 && !(*source_side)[e.getSink()]) {
+                    cut_edges->push_back(e);
+                }
+            }
+        }
+
+        return std::make_shared<dto::FlowResult>(optimal_graph, edge_flows, value,
+            std::make_shared<dto::MinCut>(source_side, cut_edges, min_cut->getCapacity()));
+    }
+}
\ No newline at end of file
@@ -0,0 +1,134 @@
+#ifndef MINIMUM_COST_FLOWS_PROBLEM_GRAPHCOMPONENTS_H
+#define MINIMUM_COST_FLOWS_PROBLEM_GRAPHCOMPONENTS_H
+
+#include "types/Types.h"
+#include "data_structures/graph/Graph.h"
+#include "dto/flowResult/FlowResult.h"
+
+#include <memory>
+#include <vector>
+
+namespace data_structures {
+    /**
+     * Class representing the weakly connected components of a graph for a source and a sink, with the mapping
+     * to merge the solutions of the components back into a solution of the graph (see merge()).
+     * No flow crosses two components, so each of them is an independent problem:
+     *  - the flow component (the one containing the source) carries the flow from the source to the sink,
+     *    if the sink is in another component it is added to the graph of the flow component as an isolated node,
+     *    so the algorithms see the same reachability from the source as on the whole graph
+     *  - every other component has no supply, its minimum cost flow is a minimum cost circulation:
+     *    the zero flow if it has no negative cost, otherwise its negative cycles must be cancelled.
+     * Only the algorithms that cancel the negative cycles of the whole graph (Cycle-Cancelling) solve the
+     * circulation components (the other components with some negative cost), which can be solved at the same time
+     * on different threads; for the other algorithms every other component keeps the zero flow.
+     * The graph of a component is built only if it has to be solved.
+     */
+    class GraphComponents {
+        public:
+            /**
+             * Split the graph in its weakly connected components.
+             *
+             * V: number of nodes
+             * E: number of edges
+             * α: inverse Ackermann function (union-find of the nodes)
+             * Time complexity: O((V + E) * α(V))
+             *
+             * @param graph        the graph to split
+             * @param source       the source node
+             * @param sink         the sink node
+             * @param circulations true if the components with negative costs other than the flow component are solved
+             *                     as circulations (see getCirculationComponents()), false if they keep the zero flow
+             *
+             * @throws invalid_argument if the source and the sink are not two different nodes of the graph
+             */
+            GraphComponents(const std::shared_ptr<Graph>& graph, int source, int sink, bool circulations);
+
+            /**
+             * Get the number of weakly connected components (an isolated node is a component).
+             *
+             * @return the number of components
+             */
+            [[nodiscard]] int getNumComponents() const { return static_cast<int>(this->component_nodes.size()); }
+
+            /**
+             * Get the component containing the source.
+             * If the sink is in another component the maximum flow is 0, the sink is an isolated node of its graph.
+             *
+             * @return the flow component
+             */
+            [[nodiscard]] int getFlowComponent() const { return this->flow_component; }
+
+            /**
+             * Get the components without the source that have some negative cost, in decreasing order of number of edges.
+             *
+             * @return the circulation components, empty if they are not solved
+             */
+            [[nodiscard]] const std::vector<int>& getCirculationComponents() const { return this->circulation_components; }
+
+            /**
+             * Get the graph of a component, whose nodes are the nodes of the component renumbered in the same order.
+             *
+             * @param component the flow component or a circulation component
+             *
+             * @return the graph of the component
+             */
+            [[nodiscard]] std::shared_ptr<Graph> getGraph(int component) const { return this->component_graphs.at(component); }
+
+            /**
+             * Get the source node in the graph of the flow component.
+             *
+             * @return the source node
+             */
+            [[nodiscard]] int getSource() const { return this->node_map[this->source]; }
+
+            /**
+             * Get the sink node in the graph of the flow component.
+             *
+             * @return the sink node
+             */
+            [[nodiscard]] int getSink() const { return this->flow_sink; }
+
+            /**
+             * Merge the solutions of the components into a solution of the graph:
+             *  - the flow of each edge is its flow in the solution of its component (0 if it has none)
+             *  - the value is the sum of the values of the solutions.
+             * The minimum cut (if the solution of the flow component has one) keeps its capacity: the nodes of the
+             * other components are on the sink side, since no edge reaches them from the source.
+             *
+             * V: number of nodes
+             * E: number of edges
+             * Time complexity: O(V + E)
+             *
+             * @param results the solution of each component (nullptr for the components that were not solved)
+             *
+             * @return the solution of the graph: the optimal graph (see utils::GraphUtils::GetOptimalGraph()),
+             *         the flow of each edge in the order of the graph, the value and the minimum cut
+             *
+             * @throws overflow_error if the sum of the values overflows
+             */
+            [[nodiscard]] std::shared_ptr<dto::FlowResult> merge(const std::vector<std::shared_ptr<dto::FlowResult>>& results) const;
+
+        private:
+            // the input graph, its source and sink
+            std::shared_ptr<Graph> graph;
+            int source;
+            int sink;
+
+            // the component of each node and its node in the graph of the component
+            std::vector<int> node_component;
+            std::vector<int> node_map;
+
+            // the nodes of each component, in increasing order
+            std::vector<std::vector<int>> component_nodes;
+
+            // the graph of each component that has to be solved (nullptr for the others)
+            std::vector<std::shared_ptr<Graph>> component_graphs;
+
+            // the flow component, the sink in its graph and the circulation components
+            int flow_component;
+            int flow_sink;
+            std::vector<int> circulation_components;
+    };
+}
+
+#endif //MINIMUM_COST_FLOWS_PROBLEM_GRAPHCOMPONENTS_H
@@ -0,0 +1,230 @@
+#include "ReducedGraph.h"
+
+#include "utils/GraphUtils.h"
+#include "utils/ArithmeticUtils.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace data_structures {
+    ReducedGraph::ReducedGraph(const std::shared_ptr<Graph>& graph, int source, int sink) : input_graph(graph), source(source), sink(sink) {
+        int num_nodes { graph->getNumNodes() };
+        if (source < 0 || sink < 0 || source >= num_nodes || sink >= num_nodes || source == sink) {
+            throw std::invalid_argument("The source and the sink must be two different nodes of the graph");
+        }
+
+        // a part for each edge with capacity (the graph has no parallel edges)
+        PartMap out_parts(num_nodes);
+        PartMap in_parts(num_nodes);
+        bool negative_costs { false };
+        for (int node = 0; node < num_nodes; node++) {
+            for (const auto& e : *graph->getNodeAdjList(node)) {
+                int edge { static_cast<int>(this->input_edges.size()) };
+                this->input_edges.push_back(e);
+                negative_costs = negative_costs || e.getCost() < 0;
+
+                if (e.getCapacity() > 0) {
+                    this->parts.push_back({ PartKind::Edge, node, e.getSink(), e.getCapacity(), e.getCost(), edge, -1, -1 });
+                    this->insertPart(out_parts, in_parts, static_cast<int>(this->parts.size()) - 1);
+                }
+            }
+        }
+
+        // remove the parts not on any source-sink path
+        this->source_reachable = ReducedGraph::reachableNodes(out_parts, source);
+        if (!negative_costs) {
+            auto sink_reachable = ReducedGraph::reachableNodes(in_parts, sink);
+            for (int node = 0; node < num_nodes; node++) {
+                for (auto it = out_parts[node].begin(); it != out_parts[node].end();) {
+                    int head { it->first };
+                    if (this->source_reachable[node] && sink_reachable[head]) {
+                        ++it;
+                        continue;
+                    }
+                    in_parts[head].erase(node);
+                    it = out_parts[node].erase(it);
+                }
+            }
+        }
+
+        // contract the nodes until nothing changes: a contraction changes only the degrees of the ends of the chain
+        std::vector<bool> contracted(num_nodes, false);
+        std::vector<int> candidates(num_nodes);
+        for (int node = 0; node < num_nodes; node++) {
+            candidates[node] = num_nodes - 1 - node;
+        }
+        while (!candidates.empty()) {
+            int node { candidates.back() };
+            candidates.pop_back();
+            if (contracted[node] || !this->contractNode(out_parts, in_parts, node)) {
+                continue;
+            }
+            contracted[node] = true;
+            candidates.push_back(this->parts.back().head);
+            candidates.push_back(this->parts.back().tail);
+        }
+
+        // renumber the nodes left, in the same order
+        this->node_map.assign(num_nodes, -1);
+        int num_reduced_nodes {};
+        for (int node = 0; node < num_nodes; node++) {
+            if (node == source || node == sink || !out_parts[node].empty() || !in_parts[node].empty()) {
+                this->node_map[node] = num_reduced_nodes++;
+            }
+        }
+        this->source = this->node_map[source];
+        this->sink = this->node_map[sink];
+
+        // the edges of each node in the order their parts were created
+        this->graph = std::make_shared<Graph>(num_reduced_nodes);
+        std::vector<int> node_parts {};
+        for (int node = 0; node < num_nodes; node++) {
+            node_parts.clear();
+            for (const auto& it : out_parts[node]) {
+                node_parts.push_back(it.second);
+            }
+            std::sort(node_parts.begin(), node_parts.end());
+
+            for (int part : node_parts) {
+                const auto& p = this->parts[part];
+                this->graph->addEdge(this->node_map[p.tail], this->node_map[p.head], p.capacity, p.cost);
+                this->edge_parts.push_back(part);
+            }
+        }
+    }
+
+    std::shared_ptr<dto::FlowResult> ReducedGraph::expand(const std::shared_ptr<dto::FlowResult>& result) const {
+        // the flow of each part, from the edges of the reduced graph down to the input edges
+        std::vector<types::capacity_t> part_flows(this->parts.size(), 0);
+        const auto& edge_flows = *result->getEdgeFlows();
+        for (std::size_t edge = 0; edge < this->edge_parts.size(); edge++) {
+            part_flows[this->edge_parts[edge]] = edge_flows[edge];
+        }
+
+        auto input_flows = std::make_shared<std::vector<types::capacity_t>>(this->input_edges.size(), 0);
+        for (auto part = static_cast<int>(this->parts.size()) - 1; part >= 0; part--) {
+            const auto& p = this->parts[part];
+            types::capacity_t flow { part_flows[part] };
+            if (p.kind == PartKind::Edge) {
+                (*input_flows)[p.first] = flow;
+            } else if (p.kind == PartKind::Series) {
+                part_flows[p.first] = flow;
+                part_flows[p.second] = flow;
+            } else {
+                types::capacity_t first_flow { std::min(flow, this->parts[p.first].capacity) };
+                part_flows[p.first] = first_flow;
+                part_flows[p.second] = flow - first_flow;
+            }
+        }
+
+        auto optimal_graph = utils::GraphUtils::GetOptimalGraph(this->input_graph, *input_flows);
+
+        auto min_cut = result->getMinCut();
+        if (!min_cut) {
+            return std::make_shared<dto::FlowResult>(optimal_graph, input_flows, result->getFlow());
+        }
+
+        // the side of the nodes left and of the removed ones, then of the contracted ones from the outer chains in
+        auto source_side = std::make_shared<std::vector<bool>>(this->node_map.size(), false);
+        for (std::size_t node = 0; node < this->node_map.size(); node++) {
+            (*source_side)[node] = this->node_map[node] != -1
+                ? min_cut->getSourceSide()->at(this->node_map[node])
+                : this->source_reachable[node];
+        }
+        for (auto part = static_cast<int>(this->parts.size()) - 1; part >= 0; part--) {
+            const auto& p = this->parts[part];
+            if (p.kind != PartKind::Series) {
+                continue;
+            }
+            if ((*source_side)[p.tail] && !(*source_side)[p.head]) {
+                // the chain is cut at its smallest capacity
+                (*source_side)[p.middle] = this->parts[p.second].capacity < this->parts[p.first].capacity;
+            } else {
+                (*source_side)[p.middle] = (*source_side)[p.tail] && (*source_side)[p.head];
+            }
+        }
+
+        auto cut_edges = std::make_shared<std::vector<Edge>>();
+        for (const auto& e : this->input_edges) {
+            if (e.getCapacity() > 0 && (*source_side)[e.getSource()] && !(*source_side)[e.getSink()]) {
+                cut_edges->push_back(e);
+            }
+        }
+
+        return std::make_shared<dto::FlowResult>(optimal_graph, input_flows, result->getFlow(),
+            std::make_shared<dto::MinCut>(source_side, cut_edges, min_cut->getCapacity()));
+    }
+
+    void ReducedGraph::insertPart(PartMap& out_parts, PartMap& in_parts, int part) {
+        int tail { this->parts[part].tail };
+        int head { this->parts[part].head };
+
+        auto it = out_parts[tail].find(head);
+        if (it != out_parts[tail].end()) {
+            int parallel { it->second };
+            this->parts.push_back({ PartKind::Parallel, tail, head,
+                this->parts[parallel].capacity + this->parts[part].capacity, this->parts[part].cost, parallel, part, -1 });
+            part = static_cast<int>(this->parts.size()) - 1;
+        }
+
+        out_parts[tail][head] = part;
+        in_parts[head][tail] = part;
+    }
+
+    bool ReducedGraph::contractNode(PartMap& out_parts, PartMap& in_parts, int node) {
+        if (in_parts[node].size() != 1 || out_parts[node].size() != 1) {
+            return false;
+        }
+
+        int first { in_parts[node].begin()->second };
+        int second { out_parts[node].begin()->second };
+        int tail { this->parts[first].tail };
+        int head { this->parts[second].head };
+        if (node == this->source || node == this->sink || tail == head || tail == node || head == node) {
+            return false;
+        }
+
+        // the chain must fit in the types of the edges and be merged with u -> v, if there is one
+        types::capacity_t capacity { std::min(this->parts[first].capacity, this->parts[second].capacity) };
+        types::cost_t cost {};
+        if (!utils::ArithmeticUtils::TryAdd(this->parts[first].cost, this->parts[second].cost, cost)) {
+            return false;
+        }
+        auto parallel = out_parts[tail].find(head);
+        if (parallel != out_parts[tail].end()) {
+            types::capacity_t sum {};
+            if (this->parts[parallel->second].cost != cost
+                || !utils::ArithmeticUtils::TryAdd(this->parts[parallel->second].capacity, capacity, sum)) {
+                return false;
+            }
+        }
+
+        out_parts[tail].erase(node);
+        in_parts[node].clear();
+        out_parts[node].clear();
+        in_parts[head].erase(node);
+
+        this->parts.push_back({ PartKind::Series, tail, head, capacity, cost, first, second, node });
+        this->insertPart(out_parts, in_parts, static_cast<int>(this->parts.size()) - 1);
+        return true;
+    }
+
+    std::vector<bool> ReducedGraph::reachableNodes(const PartMap& parts, int start) {
+        std::vector<bool> reachable(parts.size(), false);
+        std::vector<int> stack { start };
+        reachable[start] = true;
+
+        while (!stack.empty()) {
+            int node { stack.back() };
+            stack.pop_back();
+            for (const auto& it : parts[node]) {
+                if (!reachable[it.first]) {
+                    reachable[it.first] = true;
+                    stack.push_back(it.first);
+                }
+            }
+        }
+
+        return reachable;
+    }
+}
\ No newline at end of file
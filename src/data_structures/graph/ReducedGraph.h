@@ -0,0 +1,176 @@
+#ifndef MINIMUM_COST_FLOWS_PROBLEM_REDUCEDGRAPH_H
+#define MINIMUM_COST_FLOWS_PROBLEM_REDUCEDGRAPH_H
+
+#include "types/Types.h"
+#include "data_structures/graph/Graph.h"
+#include "dto/flowResult/FlowResult.h"
+
+#include <memory>
+#include <vector>
+#include <unordered_map>
+
+namespace data_structures {
+    /**
+     * Class representing a graph reduced for a source and a sink before it is solved, with the mapping
+     * to expand a solution of the reduced graph back to the input graph (see expand()).
+     * The reduction is repeated until nothing changes:
+     *  - the edges with capacity 0 are removed
+     *  - the edges not on any source-sink path (their tail is not reachable from the source or the sink
+     *    is not reachable from their head) are removed, with the nodes left without edges
+     *  - every node (except the source and the sink) with a single incoming edge u -> node and a single
+     *    outgoing edge node -> v (u != v) is contracted: the two edges become u -> v, with the minimum
+     *    of their capacities and the sum of their costs
+     *  - the parallel edges created by a contraction are merged into one edge with the sum of their capacities.
+     * Every node of a chain carries the same flow, and the flow of merged edges can be split in any way,
+     * so the maximum flow and the minimum cost of the reduced graph are the ones of the input graph.
+     *
+     * The graph cannot hold parallel edges with different costs, so a node is not contracted if the edge
+     * u -> v already exists with another cost. If some edge has a negative cost the edges off the
+     * source-sink paths are kept: they can form negative cycles, which change the minimum cost.
+     *
+     * Each edge of the reduced graph is the root of a tree of parts (input edges, chains and parallel edges):
+     * a part is created after its children, so the solution is expanded in a single pass over the parts.
+     */
+    class ReducedGraph {
+        public:
+            /**
+             * Reduce the graph for the source and the sink.
+             *
+             * V: number of nodes
+             * E: number of edges
+             * Time complexity: O(V + E) (expected)
+             *
+             * @param graph  the graph to reduce
+             * @param source the source node
+             * @param sink   the sink node
+             *
+             * @throws invalid_argument if the source and the sink are not two different nodes of the graph
+             */
+            ReducedGraph(const std::shared_ptr<Graph>& graph, int source, int sink);
+
+            /**
+             * Get the reduced graph, whose nodes are the nodes left renumbered in the same order.
+             *
+             * @return the reduced graph
+             */
+            [[nodiscard]] std::shared_ptr<Graph> getGraph() const { return this->graph; }
+
+            /**
+             * Get the source node of the reduced graph.
+             *
+             * @return the source node
+             */
+            [[nodiscard]] int getSource() const { return this->source; }
+
+            /**
+             * Get the sink node of the reduced graph.
+             *
+             * @return the sink node
+             */
+            [[nodiscard]] int getSink() const { return this->sink; }
+
+            /**
+             * Get the number of edges of the reduced graph.
+             *
+             * @return the number of edges
+             */
+            [[nodiscard]] std::size_t getNumEdges() const { return this->edge_parts.size(); }
+
+            /**
+             * Expand a solution of the reduced graph to the input graph:
+             *  - the flow of a contracted chain is the flow of each of its edges
+             *  - the flow of merged edges fills them in order, each up to its capacity
+             *  - the removed edges have no flow.
+             * The minimum cut (if the result has one) keeps its capacity: the nodes of a cut chain are split
+             * at the edge with the smallest capacity, the others are on the source side if both ends of
+             * the chain are, and the removed nodes are on the source side if they are reachable from the source.
+             *
+             * V: number of nodes
+             * E: number of edges
+             * Time complexity: O(V + E)
+             *
+             * @param result the solution of the reduced graph
+             *
+             * @return the solution of the input graph: the optimal graph (see utils::GraphUtils::GetOptimalGraph()),
+             *         the flow of each edge in the order of the input graph, the value and the minimum cut
+             */
+            [[nodiscard]] std::shared_ptr<dto::FlowResult> expand(const std::shared_ptr<dto::FlowResult>& result) const;
+
+        private:
+            /**
+             * Kind of a part of an edge of the reduced graph.
+             */
+            enum class PartKind {
+                Edge,       // an edge of the input graph
+                Series,     // a chain: first -> middle node -> second
+                Parallel    // two parallel edges
+            };
+
+            /**
+             * Part of an edge of the reduced graph, tail -> head.
+             */
+            struct Part {
+                PartKind kind;
+                int tail;
+                int head;
+                types::capacity_t capacity;
+                types::cost_t cost;
+                int first;      // Edge: the index of the input edge, otherwise the first child
+                int second;     // the second child (-1 for Edge)
+                int middle;     // Series: the contracted node (-1 otherwise)
+            };
+
+            // for each node, the parts leaving (or entering) it by their head (or tail)
+            using PartMap = std::vector<std::unordered_map<int, int>>;
+
+            /**
+             * Add a part to the adjacency of its nodes, merging it with the part between the same nodes.
+             *
+             * @param out_parts the parts leaving each node
+             * @param in_parts  the parts entering each node
+             * @param part      the part, with no parallel part or one with the same cost
+             */
+            void insertPart(PartMap& out_parts, PartMap& in_parts, int part);
+
+            /**
+             * Contract the node if it has a single incoming part u -> node and a single outgoing part node -> v.
+             *
+             * @param out_parts the parts leaving each node
+             * @param in_parts  the parts entering each node
+             * @param node      the node
+             *
+             * @return true if the node was contracted, false otherwise
+             */
+            bool contractNode(PartMap& out_parts, PartMap& in_parts, int node);
+
+            /**
+             * Mark the nodes reachable from a node following the parts in one direction.
+             *
+             * @param parts the parts leaving (or entering) each node
+             * @param start the starting node
+             *
+             * @return the reachable nodes
+             */
+            static std::vector<bool> reachableNodes(const PartMap& parts, int start);
+
+            // the input graph and its edges in the order of the adjacency lists
+            std::shared_ptr<Graph> input_graph;
+            std::vector<Edge> input_edges;
+
+            // the reduced graph, its source and sink (the input ones while the graph is reduced)
+            std::shared_ptr<Graph> graph;
+            int source;
+            int sink;
+
+            // the parts, the root part of each edge of the reduced graph and the node of the reduced graph
+            // of each input node (-1 if it was removed or contracted)
+            std::vector<Part> parts;
+            std::vector<int> edge_parts;
+            std::vector<int> node_map;
+
+            // the input nodes reachable from the input source (see expand())
+            std::vector<bool> source_reachable;
+    };
+}
+
+#endif //MINIMUM_COST_FLOWS_PROBLEM_REDUCEDGRAPH_H
@@ -0,0 +1,175 @@
+#include "ReorderedGraph.h"
+
+#include "utils/GraphUtils.h"
+
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+
+namespace data_structures {
+    ReorderedGraph::Order ReorderedGraph::ParseOrder(const std::string& name) {
+        if (name == "bfs") {
+            return Order::Bfs;
+        }
+        if (name == "rcm") {
+            return Order::ReverseCuthillMcKee;
+        }
+        throw std::invalid_argument("Unknown node order " + name + " (bfs or rcm)");
+    }
+
+    ReorderedGraph::ReorderedGraph(const std::shared_ptr<Graph>& graph, int source, int sink, Order order) :
+        input_graph(graph), source(source), sink(sink) {
+
+        int num_nodes { graph->getNumNodes() };
+        if (source < 0 || sink < 0 || source >= num_nodes || sink >= num_nodes || source == sink) {
+            throw std::invalid_argument("The source and the sink must be two different nodes of the graph");
+        }
+
+        // the first input edge of each node and the neighbours of each node in the undirected graph
+        std::vector<std::size_t> first_edge(num_nodes + 1, 0);
+        std::vector<std::vector<int>> neighbours(num_nodes);
+        for (int node = 0; node < num_nodes; node++) {
+            auto adj_list = graph->getNodeAdjList(node);
+            for (const auto& e : *adj_list) {
+                neighbours[node].push_back(e.getSink());
+                neighbours[e.getSink()].push_back(node);
+            }
+            first_edge[node + 1] = first_edge[node] + adj_list->size();
+        }
+
+        std::vector<bool> visited(num_nodes, false);
+        std::size_t last_level {};
+        this->old_ids.reserve(num_nodes);
+        if (order == Order::Bfs) {
+            // the component of the source first, then the others in the order of their first node
+            ReorderedGraph::appendBfs(neighbours, source, visited, this->old_ids, last_level);
+            for (int node = 0; node < num_nodes; node++) {
+                if (!visited[node]) {
+                    ReorderedGraph::appendBfs(neighbours, node, visited, this->old_ids, last_level);
+                }
+            }
+        } else {
+            auto degree_less = [&neighbours](int a, int b) {
+                return std::make_pair(neighbours[a].size(), a) < std::make_pair(neighbours[b].size(), b);
+            };
+            for (auto& node_neighbours : neighbours) {
+                std::sort(node_neighbours.begin(), node_neighbours.end(), degree_less);
+            }
+
+            std::vector<bool> probed(num_nodes, false);
+            std::vector<int> component {};
+            for (int node = 0; node < num_nodes; node++) {
+                if (visited[node]) {
+                    continue;
+                }
+
+                // pseudo-peripheral node (George and Liu): from the node of minimum degree of the component,
+                // move to the node of minimum degree of the last level of the search while the search gets deeper
+                component.clear();
+                ReorderedGraph::appendBfs(neighbours, node, probed, component, last_level);
+                int start { *std::min_element(component.begin(), component.end(), degree_less) };
+                int peripheral { start };
+                int depth { 0 };
+                while (true) {
+                    for (int probed_node : component) {
+                        probed[probed_node] = false;
+                    }
+                    component.clear();
+                    int start_depth { ReorderedGraph::appendBfs(neighbours, start, probed, component, last_level) };
+                    if (start_depth <= depth) {
+                        break;
+                    }
+                    depth = start_depth;
+                    peripheral = start;
+                    start = *std::min_element(component.begin() + static_cast<std::ptrdiff_t>(last_level), component.end(), degree_less);
+                }
+                for (int probed_node : component) {
+                    probed[probed_node] = false;
+                }
+
+                ReorderedGraph::appendBfs(neighbours, peripheral, visited, this->old_ids, last_level);
+            }
+            std::reverse(this->old_ids.begin(), this->old_ids.end());
+        }
+
+        this->new_ids.assign(num_nodes, -1);
+        for (int node = 0; node < num_nodes; node++) {
+            this->new_ids[this->old_ids[node]] = node;
+        }
+
+        // the edges of each node sorted by the new id of their head
+        this->graph = std::make_shared<Graph>(num_nodes);
+        this->edge_map.reserve(first_edge[num_nodes]);
+        std::vector<std::pair<int, std::size_t>> node_edges {};
+        for (int node = 0; node < num_nodes; node++) {
+            int old_node { this->old_ids[node] };
+            auto adj_list = graph->getNodeAdjList(old_node);
+            node_edges.clear();
+            for (std::size_t i = 0; i < adj_list->size(); i++) {
+                node_edges.emplace_back(this->new_ids[(*adj_list)[i].getSink()], i);
+            }
+            std::sort(node_edges.begin(), node_edges.end());
+
+            for (const auto& [head, i] : node_edges) {
+                const auto& e = (*adj_list)[i];
+                this->graph->addEdge(node, head, e.getCapacity(), e.getCost());
+                this->edge_map.push_back(first_edge[old_node] + i);
+            }
+        }
+    }
+
+    std::shared_ptr<dto::FlowResult> ReorderedGraph::restore(const std::shared_ptr<dto::FlowResult>& result) const {
+        const auto& edge_flows = *result->getEdgeFlows();
+        auto input_flows = std::make_shared<std::vector<types::capacity_t>>(this->edge_map.size(), 0);
+        for (std::size_t edge = 0; edge < this->edge_map.size(); edge++) {
+            (*input_flows)[this->edge_map[edge]] = edge_flows[edge];
+        }
+
+        auto optimal_graph = utils::GraphUtils::GetOptimalGraph(this->input_graph, *input_flows);
+
+        auto min_cut = result->getMinCut();
+        if (!min_cut) {
+            return std::make_shared<dto::FlowResult>(optimal_graph, input_flows, result->getFlow());
+        }
+
+        auto source_side = std::make_shared<std::vector<bool>>(this->new_ids.size(), false);
+        for (std::size_t node = 0; node < this->new_ids.size(); node++) {
+            (*source_side)[node] = min_cut->getSourceSide()->at(this->new_ids[node]);
+        }
+
+        auto cut_edges = std::make_shared<std::vector<Edge>>();
+        for (const auto& e : *min_cut->getCutEdges()) {
+            cut_edges->emplace_back(this->old_ids[e.getSource()], this->old_ids[e.getSink()], e.getCapacity(), e.getCost());
+        }
+
+        return std::make_shared<dto::FlowResult>(optimal_graph, input_flows, result->getFlow(),
+            std::make_shared<dto::MinCut>(source_side, cut_edges, min_cut->getCapacity()));
+    }
+
+    int ReorderedGraph::appendBfs(const std::vector<std::vector<int>>& neighbours, int start,
+        std::vector<bool>& visited, std::vector<int>& order, std::size_t& last_level) {
+
+        // the order is the queue, a level ends where the next one starts
+        std::size_t level_begin { order.size() };
+        order.push_back(start);
+        visited[start] = true;
+        int num_levels {};
+
+        while (level_begin < order.size()) {
+            std::size_t level_end { order.size() };
+            last_level = level_begin;
+            num_levels++;
+            for (std::size_t i = level_begin; i < level_end; i++) {
+                for (int neighbour : neighbours[order[i]]) {
+                    if (!visited[neighbour]) {
+                        visited[neighbour] = true;
+                        order.push_back(neighbour);
+                    }
+                }
+            }
+            level_begin = level_end;
+        }
+
+        return num_levels;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,126 @@
+#ifndef MINIMUM_COST_FLOWS_PROBLEM_REORDEREDGRAPH_H
+#define MINIMUM_COST_FLOWS_PROBLEM_REORDEREDGRAPH_H
+
+#include "types/Types.h"
+#include "data_structures/graph/Graph.h"
+#include "dto/flowResult/FlowResult.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace data_structures {
+    /**
+     * Class representing a graph whose nodes are renumbered so that the nodes close in the graph get close ids,
+     * with the permutation to restore a solution of the renumbered graph to the input graph (see restore()).
+     * The input ids usually come from an external numbering: the residual network stores the arcs of each node
+     * in the order of the ids (see ResidualNetwork), so with a locality order the searches (BFS, Dijkstra,
+     * Bellman-Ford) read the arcs and the labels of the nodes near to each other from near memory.
+     * The edges of each node are sorted by the new id of their head.
+     * The orders (on the undirected graph, one component after the other):
+     *  - Bfs: breadth-first order from the source
+     *  - ReverseCuthillMcKee: breadth-first order visiting the neighbours by increasing degree, from a
+     *    pseudo-peripheral node of each component, reversed (it minimizes the bandwidth of the adjacency matrix).
+     *
+     * (see: https://en.wikipedia.org/wiki/Cuthill%E2%80%93McKee_algorithm)
+     */
+    class ReorderedGraph {
+        public:
+            /**
+             * Order of the nodes.
+             */
+            enum class Order { Bfs, ReverseCuthillMcKee };
+
+            /**
+             * Get the order from its name: "bfs" or "rcm".
+             *
+             * @param name the name of the order
+             *
+             * @return the order
+             *
+             * @throws invalid_argument if the name is not an order
+             */
+            static Order ParseOrder(const std::string& name);
+
+            /**
+             * Renumber the nodes of the graph.
+             *
+             * V: number of nodes
+             * E: number of edges
+             * Time complexity: O(V + E * log(E))
+             *
+             * @param graph  the graph to renumber
+             * @param source the source node
+             * @param sink   the sink node
+             * @param order  the order of the nodes
+             *
+             * @throws invalid_argument if the source and the sink are not two different nodes of the graph
+             */
+            ReorderedGraph(const std::shared_ptr<Graph>& graph, int source, int sink, Order order);
+
+            /**
+             * Get the renumbered graph.
+             *
+             * @return the renumbered graph
+             */
+            [[nodiscard]] std::shared_ptr<Graph> getGraph() const { return this->graph; }
+
+            /**
+             * Get the source node of the renumbered graph.
+             *
+             * @return the source node
+             */
+            [[nodiscard]] int getSource() const { return this->new_ids[this->source]; }
+
+            /**
+             * Get the sink node of the renumbered graph.
+             *
+             * @return the sink node
+             */
+            [[nodiscard]] int getSink() const { return this->new_ids[this->sink]; }
+
+            /**
+             * Restore a solution of the renumbered graph to the input graph:
+             * the flow of each edge and the minimum cut (if the result has one) are mapped back by the inverse permutation.
+             *
+             * V: number of nodes
+             * E: number of edges
+             * Time complexity: O(V + E)
+             *
+             * @param result the solution of the renumbered graph
+             *
+             * @return the solution of the input graph: the optimal graph (see utils::GraphUtils::GetOptimalGraph()),
+             *         the flow of each edge in the order of the input graph, the value and the minimum cut
+             */
+            [[nodiscard]] std::shared_ptr<dto::FlowResult> restore(const std::shared_ptr<dto::FlowResult>& result) const;
+
+        private:
+            /**
+             * Breadth-first search on the undirected graph from a node, appending the nodes reached to the order.
+             *
+             * @param neighbours the neighbours of each node (sorted by increasing degree for Cuthill-McKee)
+             * @param start      the starting node, not visited
+             * @param visited    the nodes already in the order, updated
+             * @param order      the order, the nodes reached are appended level by level
+             * @param last_level output: the index in the order of the first node of the last level
+             *
+             * @return the number of levels
+             */
+            static int appendBfs(const std::vector<std::vector<int>>& neighbours, int start,
+                std::vector<bool>& visited, std::vector<int>& order, std::size_t& last_level);
+
+            // the input graph, its source and sink
+            std::shared_ptr<Graph> input_graph;
+            int source;
+            int sink;
+
+            // the renumbered graph, the new id of each input node, the input node of each new id
+            // and the input edge of each edge of the renumbered graph (in the order of the adjacency lists)
+            std::shared_ptr<Graph> graph;
+            std::vector<int> new_ids;
+            std::vector<int> old_ids;
+            std::vector<std::size_t> edge_map;
+    };
+}
+
+#endif //MINIMUM_COST_FLOWS_PROBLEM_REORDEREDGRAPH_H
@@ -0,0 +1,148 @@
+#include "ResidualNetwork.h"
+
+#include "utils/ArithmeticUtils.h"
+#include "consts/Consts.h"
+
+#include <limits>
+#include <cstdlib>
+#include <stdexcept>
+#include <algorithm>
+
+namespace data_structures {
+    ResidualNetwork::ResidualNetwork(const std::shared_ptr<Graph>& graph) :
+        num_nodes(graph->getNumNodes()),
+        max_abs_potential(0),
+        max_abs_cost(0) {
+
+        auto arrays = std::make_shared<ArcArrays>();
+
+        // count the arcs leaving each node (the forward arcs of its edges and the twins of its entering edges)
+        arrays->first_arc.assign(this->num_nodes + 1, 0);
+        for (int source = 0; source < this->num_nodes; source++) {
+            for (const auto& e : *graph->getNodeAdjList(source)) {
+                arrays->first_arc.at(source + 1)++;
+                arrays->first_arc.at(e.getSink() + 1)++;
+            }
+        }
+        for (int node = 0; node < this->num_nodes; node++) {
+            arrays->first_arc.at(node + 1) += arrays->first_arc.at(node);
+        }
+
+        this->num_arcs = arrays->first_arc.back();
+        arrays->tails.resize(this->num_arcs);
+        arrays->heads.resize(this->num_arcs);
+        arrays->twins.resize(this->num_arcs);
+        arrays->forward.resize(this->num_arcs);
+        arrays->costs.resize(this->num_arcs);
+        this->residual_capacities.resize(this->num_arcs);
+
+        // fill the arcs, next_arc[u] is the next free position in the range of u
+        std::vector<int> next_arc(arrays->first_arc.begin(), arrays->first_arc.end() - 1);
+        for (int source = 0; source < this->num_nodes; source++) {
+            for (const auto& e : *graph->getNodeAdjList(source)) {
+                int sink { e.getSink() };
+                int arc { next_arc.at(source)++ };
+                int twin { next_arc.at(sink)++ };
+
+                arrays->tails.at(arc) = source;
+                arrays->heads.at(arc) = sink;
+                arrays->twins.at(arc) = twin;
+                arrays->forward.at(arc) = 1;
+                arrays->costs.at(arc) = e.getCost();
+                this->residual_capacities.at(arc) = e.getCapacity();
+
+                arrays->tails.at(twin) = sink;
+                arrays->heads.at(twin) = source;
+                arrays->twins.at(twin) = arc;
+                arrays->forward.at(twin) = 0;
+                arrays->costs.at(twin) = utils::ArithmeticUtils::CheckedSub<types::cost_t>(0, e.getCost());
+                this->residual_capacities.at(twin) = 0;
+
+                this->max_abs_cost = std::max<types::accumulator_t>(this->max_abs_cost, std::abs(static_cast<types::accumulator_t>(e.getCost())));
+            }
+        }
+
+        this->first_arc = arrays->first_arc.data();
+        this->tails = arrays->tails.data();
+        this->heads = arrays->heads.data();
+        this->twins = arrays->twins.data();
+        this->forward = arrays->forward.data();
+        this->costs = arrays->costs.data();
+        this->arc_storage = std::move(arrays);
+
+        // with zero potentials the reduced costs are the costs
+        this->potentials.assign(this->num_nodes, 0);
+    }
+
+    ResidualNetwork::ResidualNetwork(const std::shared_ptr<GraphSnapshot>& snapshot) :
+        num_nodes(snapshot->getNumNodes()),
+        num_arcs(snapshot->getNumArcs()),
+        arc_storage(snapshot),
+        first_arc(snapshot->getFirstArcs()),
+        tails(snapshot->getTails()),
+        heads(snapshot->getHeads()),
+        twins(snapshot->getTwins()),
+        forward(snapshot->getForward()),
+        costs(snapshot->getCosts()),
+        residual_capacities(snapshot->getCapacities(), snapshot->getCapacities() + snapshot->getNumArcs()),
+        potentials(snapshot->getNumNodes(), 0),
+        max_abs_potential(0),
+        max_abs_cost(snapshot->getMaxAbsCost()) {}
+
+    void ResidualNetwork::pushFlow(int arc, types::capacity_t flow) {
+        if (this->residual_capacities.at(arc) < flow) {
+            throw std::invalid_argument("The flow is greater than the residual capacity of the edge");
+        }
+
+        int twin { this->twins[arc] };
+        this->residual_capacities.at(arc) -= flow;
+        this->residual_capacities.at(twin) = utils::ArithmeticUtils::CheckedAdd(this->residual_capacities.at(twin), flow);
+    }
+
+    void ResidualNetwork::setResidualCapacities(const std::vector<types::capacity_t>& residual_capacities) {
+        if (residual_capacities.size() != this->residual_capacities.size()) {
+            throw std::invalid_argument("The number of residual capacities is not equal to the number of arcs");
+        }
+
+        std::copy(residual_capacities.begin(), residual_capacities.end(), this->residual_capacities.begin());
+    }
+
+    void ResidualNetwork::makeUndirected() {
+        for (int arc = 0; arc < this->getNumArcs(); arc++) {
+            if (this->forward[arc]) {
+                this->residual_capacities[this->twins[arc]] = this->residual_capacities[arc];
+            }
+        }
+    }
+
+    void ResidualNetwork::initPotentials(const std::vector<types::accumulator_t>& distance) {
+        this->max_abs_potential = 0;
+        for (int node = 0; node < this->num_nodes; node++) {
+            this->potentials[node] = distance[node] == consts::infinite_distance ? 0 : -distance[node];
+            this->max_abs_potential = std::max(this->max_abs_potential, std::abs(this->potentials[node]));
+        }
+
+        this->checkPotentials();
+    }
+
+    void ResidualNetwork::updatePotentials(const std::shared_ptr<DijkstraWorkspace>& workspace, types::accumulator_t max_distance) {
+        for (int node : workspace->getSettledNodes()) {
+            types::accumulator_t node_distance { workspace->getDistance(node) };
+            if (node_distance >= max_distance) {
+                continue;
+            }
+
+            auto shift { utils::ArithmeticUtils::CheckedSub(max_distance, node_distance) };
+            this->potentials[node] = utils::ArithmeticUtils::CheckedAdd(this->potentials[node], shift);
+            this->max_abs_potential = std::max(this->max_abs_potential, std::abs(this->potentials[node]));
+        }
+
+        this->checkPotentials();
+    }
+
+    void ResidualNetwork::checkPotentials() const {
+        if (this->max_abs_potential > (std::numeric_limits<types::accumulator_t>::max() - this->max_abs_cost) / 2) {
+            throw std::overflow_error("integer overflow in the reduced costs");
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,321 @@
+#ifndef MINIMUM_COST_FLOWS_PROBLEM_RESIDUALNETWORK_H
+#define MINIMUM_COST_FLOWS_PROBLEM_RESIDUALNETWORK_H
+
+#include "types/Types.h"
+#include "data_structures/graph/Graph.h"
+#include "data_structures/snapshot/GraphSnapshot.h"
+#include "data_structures/workspace/DijkstraWorkspace.h"
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+namespace data_structures {
+    /**
+     * Class representing a residual network stored in CSR (compressed sparse row) format.
+     * Every edge u -> v of the input graph is stored as two arcs:
+     *  - the forward arc u -> v, with residual capacity (capacity - flow) and the edge cost
+     *  - the backward arc v -> u (its twin), with residual capacity (flow) and the opposite cost.
+     * The arcs leaving a node are stored contiguously ([getFirstArc(node), getLastArc(node)) range)
+     * and every arc attribute (tail, head, residual capacity, cost, ...) is stored in its own array
+     * (structure of arrays), so the full-network passes read contiguous memory and can be vectorised.
+     *
+     * Sending flow only changes residual capacities, arcs are never added or removed.
+     * The arc accessors are defined in the header so that they are inlined in the algorithms' inner loops.
+     *
+     * The arrays that never change (the CSR offsets, tails, heads, twins, directions and costs) are shared
+     * by the copies of the network, and with the other processes when it is built on a GraphSnapshot:
+     * only the residual capacities and the node potentials belong to each network.
+     *
+     * The reduced costs are never stored: they are evaluated on the fly from the costs and the node potentials
+     * (see getReducedCost()), and after a shortest path search only the potentials of the nodes it settled
+     * are updated (see updatePotentials()), so nothing is proportional to the size of the network.
+     */
+    class ResidualNetwork {
+        public:
+            /**
+             * Build the residual network of the graph with zero flow.
+             * Every edge has its own pair of arcs, also when the graph has its anti-parallel edge
+             * (u -> v and the twin of v -> u are then two parallel arcs), so no node is added.
+             * The forward arcs leaving a node are in the order of its edges (see GraphUtils::GetEdgeFlows()),
+             * the edges with capacity 0 included.
+             *
+             * E: number of edges
+             * V: number of nodes
+             * Time complexity: O(V + E)
+             *
+             * @param graph the graph
+             */
+            explicit ResidualNetwork(const std::shared_ptr<Graph>& graph);
+
+            /**
+             * Build the residual network of a snapshot with zero flow: the arrays of the arcs are read
+             * from the shared memory, only the residual capacities and the node potentials are allocated.
+             *
+             * E: number of edges
+             * Time complexity: O(E)
+             *
+             * @param snapshot the snapshot
+             */
+            explicit ResidualNetwork(const std::shared_ptr<GraphSnapshot>& snapshot);
+
+            /**
+             * Get the number of nodes.
+             *
+             * @return the number of nodes
+             */
+            [[nodiscard]] int getNumNodes() const { return this->num_nodes; }
+
+            /**
+             * Get the number of arcs (forward and backward).
+             *
+             * @return the number of arcs
+             */
+            [[nodiscard]] int getNumArcs() const { return this->num_arcs; }
+
+            /**
+             * Get the first arc leaving the node.
+             *
+             * @param node the node
+             *
+             * @return the index of the first arc leaving the node
+             */
+            [[nodiscard]] int getFirstArc(int node) const { return this->first_arc[node]; }
+
+            /**
+             * Get the end (one past the last arc) of the arcs leaving the node.
+             *
+             * @param node the node
+             *
+             * @return the index following the last arc leaving the node
+             */
+            [[nodiscard]] int getLastArc(int node) const { return this->first_arc[node + 1]; }
+
+            /**
+             * Get the tail (start node) of the arc.
+             *
+             * @param arc the arc
+             *
+             * @return the tail of the arc
+             */
+            [[nodiscard]] int getTail(int arc) const { return this->tails[arc]; }
+
+            /**
+             * Get the head (end node) of the arc.
+             *
+             * @param arc the arc
+             *
+             * @return the head of the arc
+             */
+            [[nodiscard]] int getHead(int arc) const { return this->heads[arc]; }
+
+            /**
+             * Get the twin of the arc (the backward arc of a forward arc and vice versa).
+             *
+             * @param arc the arc
+             *
+             * @return the twin of the arc
+             */
+            [[nodiscard]] int getTwin(int arc) const { return this->twins[arc]; }
+
+            /**
+             * Check if the arc is a forward arc (an edge of the input graph).
+             *
+             * @param arc the arc
+             *
+             * @return true if the arc is a forward arc, false if it is a backward arc
+             */
+            [[nodiscard]] bool isForward(int arc) const { return this->forward[arc]; }
+
+            /**
+             * Get the residual capacity of the arc.
+             *
+             * @param arc the arc
+             *
+             * @return the residual capacity of the arc
+             */
+            [[nodiscard]] types::capacity_t getResidualCapacity(int arc) const { return this->residual_capacities[arc]; }
+
+            /**
+             * Get the cost of the arc (the opposite of the edge cost for backward arcs).
+             *
+             * @param arc the arc
+             *
+             * @return the cost of the arc
+             */
+            [[nodiscard]] types::cost_t getCost(int arc) const { return this->costs[arc]; }
+
+            /**
+             * Get the reduced cost of the arc with the current node potentials:
+             *   reduced_cost(u -> v) = cost(u -> v) - potential(u) + potential(v)
+             * It cannot overflow, the bounds of the potentials are checked when they are set.
+             *
+             * @param arc the arc
+             *
+             * @return the reduced cost of the arc
+             */
+            [[nodiscard]] types::accumulator_t getReducedCost(int arc) const {
+                return this->costs[arc] - this->potentials[this->tails[arc]] + this->potentials[this->heads[arc]];
+            }
+
+            /**
+             * Check if the arc is admissible: it has positive residual capacity and zero reduced cost.
+             * The admissible arcs are a view of the network, they change with the flow and the potentials.
+             *
+             * @param arc the arc
+             *
+             * @return true if the arc is admissible, false otherwise
+             */
+            [[nodiscard]] bool isAdmissible(int arc) const { return this->residual_capacities[arc] > 0 && this->getReducedCost(arc) == 0; }
+
+            /**
+             * Get the potential of the node.
+             *
+             * @param node the node
+             *
+             * @return the potential of the node
+             */
+            [[nodiscard]] types::accumulator_t getPotential(int node) const { return this->potentials[node]; }
+
+            /**
+             * Send flow through the arc: its residual capacity decreases and the one of its twin increases.
+             *
+             * @param arc  the arc
+             * @param flow the flow to send
+             *
+             * @throws invalid_argument if the residual capacity of the arc is less than the flow to send
+             * @throws overflow_error   if the residual capacity of the twin overflows
+             */
+            void pushFlow(int arc, types::capacity_t flow);
+
+            /**
+             * Get the residual capacity of every arc, e.g. to restore it later with setResidualCapacities().
+             *
+             * @return the residual capacity of each arc
+             */
+            [[nodiscard]] const std::vector<types::capacity_t>& getResidualCapacities() const { return this->residual_capacities; }
+
+            /**
+             * Overwrite the residual capacity of every arc, reusing the buffer of the network
+             * (e.g. to remove the flow sent by a previous algorithm).
+             *
+             * E: number of edges
+             * Time complexity: O(E)
+             *
+             * @param residual_capacities the residual capacity of each arc
+             *
+             * @throws invalid_argument if the number of capacities is not equal to the number of arcs
+             */
+            void setResidualCapacities(const std::vector<types::capacity_t>& residual_capacities);
+
+            /**
+             * Make the network undirected: every backward arc gets the residual capacity of its forward arc,
+             * so each pair of twin arcs represents an undirected edge that can be crossed in both directions.
+             * The input graph must not have anti-parallel edges (merge them into a single edge first).
+             *
+             * E: number of edges
+             * Time complexity: O(E)
+             */
+            void makeUndirected();
+
+            /**
+             * Seed the node potentials with the distances from a node computed using the costs (Johnson's reweighting):
+             *   potential(u) = -distance(u)
+             * Without negative cycles every arc with positive residual capacity between two reached nodes
+             * gets a non-negative reduced cost. The nodes that were not reached get potential 0:
+             * they cannot be reached by sending flow from the same node either.
+             *
+             * V: number of nodes
+             * Time complexity: O(V)
+             *
+             * @param distance the distance of each node (consts::infinite_distance if not reached)
+             *
+             * @throws overflow_error if a reduced cost could overflow
+             */
+            void initPotentials(const std::vector<types::accumulator_t>& distance);
+
+            /**
+             * Update the node potentials after a shortest path search using the reduced costs:
+             *   potential(u) = potential(u) - min(distance(u), max_distance)
+             * The distances are capped to max_distance (the distance of the target node): the arcs on the
+             * shortest paths get zero reduced cost, and the arcs leaving the nodes that are farther
+             * (or not reachable) keep a non-negative reduced cost.
+             * Adding the same value to every potential does not change the reduced costs, so max_distance
+             * is added to all of them: only the nodes settled closer than the target change,
+             *   potential(u) = potential(u) + max_distance - distance(u)
+             * and the other nodes, which need not be visited, keep their potential.
+             *
+             * V': number of nodes settled by the search
+             * Time complexity: O(V')
+             *
+             * @param workspace    the workspace of the search (see GraphBaseAlgorithms::Dijkstra())
+             * @param max_distance the distance of the target node of the shortest path
+             *
+             * @throws overflow_error if a reduced cost could overflow
+             */
+            void updatePotentials(const std::shared_ptr<DijkstraWorkspace>& workspace, types::accumulator_t max_distance);
+
+        private:
+            /**
+             * Check that no reduced cost can overflow with the current potentials:
+             *   |cost - potential(u) + potential(v)| <= max|cost| + 2 * max|potential|
+             * using the bound on the potentials kept by initPotentials() and updatePotentials().
+             *
+             * @throws overflow_error if a reduced cost could overflow
+             */
+            void checkPotentials() const;
+
+            /**
+             * Arrays of the arcs of a network built from a graph.
+             */
+            struct ArcArrays {
+                std::vector<int> first_arc;
+                std::vector<int> tails;
+                std::vector<int> heads;
+                std::vector<int> twins;
+                std::vector<std::uint8_t> forward;
+                std::vector<types::cost_t> costs;
+            };
+
+            // number of nodes
+            int num_nodes;
+
+            // number of arcs
+            int num_arcs;
+
+            // owner of the read-only arrays below (ArcArrays or GraphSnapshot), shared by the copies of the network
+            std::shared_ptr<const void> arc_storage;
+
+            // the arcs leaving node u are in [first_arc[u], first_arc[u + 1])
+            const int* first_arc;
+
+            // tail of each arc
+            const int* tails;
+
+            // head of each arc
+            const int* heads;
+
+            // twin of each arc
+            const int* twins;
+
+            // 1 for the forward arcs, 0 for the backward arcs
+            const std::uint8_t* forward;
+
+            // cost of each arc
+            const types::cost_t* costs;
+
+            // residual capacity of each arc
+            std::vector<types::capacity_t> residual_capacities;
+
+            // potential of each node (see getReducedCost())
+            std::vector<types::accumulator_t> potentials;
+
+            // upper bound of the absolute value of the potentials
+            types::accumulator_t max_abs_potential;
+
+            // maximum absolute value of the costs (used to check the reduced costs overflow)
+            types::accumulator_t max_abs_cost;
+    };
+}
+
+#endif //MINIMUM_COST_FLOWS_PROBLEM_RESIDUALNETWORK_H
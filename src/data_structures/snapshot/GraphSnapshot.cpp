@@ -0,0 +1,292 @@
+#include "GraphSnapshot.h"
+
+#include "data_structures/graph/ResidualNetwork.h"
+
+#include <atomic>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+#include <vector>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace data_structures {
+    namespace {
+        // arrays of the segment, in order
+        enum Section {
+            FirstArc, Tails, Heads, Twins, Forward, Costs, Capacities,
+            EdgeSources, EdgeSinks, EdgeCapacities, EdgeCosts, EdgeArcs,
+            NumSections
+        };
+
+        constexpr char snapshot_magic[8] { 'N', 'F', 'S', 'N', 'A', 'P', 0, 0 };
+        constexpr std::uint32_t snapshot_version { 2 };
+
+        // the arrays start at multiples of the cache line size
+        constexpr std::uint64_t section_alignment { 64 };
+
+        /**
+         * Header of the segment, only fixed width fields.
+         */
+        struct Header {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t complete;         // set to 1 after everything else is written
+            std::uint32_t capacity_bytes;   // sizeof(types::capacity_t) of the writer
+            std::uint32_t cost_bytes;       // sizeof(types::cost_t) of the writer
+            std::int32_t num_nodes;
+            std::int32_t num_arcs;
+            std::int32_t num_edges;
+            std::uint32_t unit_capacities;
+            std::int64_t max_abs_cost;
+            std::uint64_t size;
+            std::uint64_t offsets[NumSections];
+            std::uint64_t lengths[NumSections];  // in bytes
+        };
+
+        std::uint64_t align(std::uint64_t offset) {
+            return (offset + section_alignment - 1) / section_alignment * section_alignment;
+        }
+
+        std::string errorMessage(const std::string& message, const std::string& name) {
+            return message + " " + name + ": " + std::strerror(errno);
+        }
+    }
+
+    std::size_t GraphSnapshot::Publish(const std::string& name, const std::shared_ptr<Graph>& graph,
+        const std::shared_ptr<ResidualNetwork>& network) {
+
+        int num_nodes { network->getNumNodes() };
+        int num_arcs { network->getNumArcs() };
+        if (num_nodes != graph->getNumNodes()) {
+            throw std::invalid_argument("The residual network is not the network of the graph");
+        }
+
+        // the edges of the input graph and the forward arc carrying the flow of each of them
+        std::vector<int> edge_sources {};
+        std::vector<int> edge_sinks {};
+        std::vector<types::capacity_t> edge_capacities {};
+        std::vector<types::cost_t> edge_costs {};
+        std::vector<int> edge_arcs {};
+        bool unit_capacities { true };
+        for (int source = 0; source < num_nodes; source++) {
+            std::size_t first_edge { edge_sources.size() };
+            for (const auto& e : *graph->getNodeAdjList(source)) {
+                edge_sources.push_back(e.getSource());
+                edge_sinks.push_back(e.getSink());
+                edge_capacities.push_back(e.getCapacity());
+                edge_costs.push_back(e.getCost());
+                edge_arcs.push_back(-1);
+                unit_capacities = unit_capacities && e.getCapacity() == 1;
+            }
+
+            // the i-th forward arc leaving the node is its i-th edge
+            std::size_t edge { first_edge };
+            for (int arc = network->getFirstArc(source); arc < network->getLastArc(source); arc++) {
+                if (network->isForward(arc)) {
+                    if (edge == edge_arcs.size() || network->getHead(arc) != edge_sinks[edge]) {
+                        throw std::invalid_argument("The residual network is not the network of the graph");
+                    }
+                    edge_arcs[edge++] = arc;
+                }
+            }
+            if (edge != edge_arcs.size()) {
+                throw std::invalid_argument("The residual network is not the network of the graph");
+            }
+        }
+
+        // the arrays of the residual network
+        std::vector<int> first_arc(num_nodes + 1);
+        std::vector<int> tails(num_arcs);
+        std::vector<int> heads(num_arcs);
+        std::vector<int> twins(num_arcs);
+        std::vector<std::uint8_t> forward(num_arcs);
+        std::vector<types::cost_t> costs(num_arcs);
+        types::accumulator_t max_abs_cost {};
+        for (int node = 0; node <= num_nodes; node++) {
+            first_arc[node] = node < num_nodes ? network->getFirstArc(node) : num_arcs;
+        }
+        for (int arc = 0; arc < num_arcs; arc++) {
+            tails[arc] = network->getTail(arc);
+            heads[arc] = network->getHead(arc);
+            twins[arc] = network->getTwin(arc);
+            forward[arc] = network->isForward(arc);
+            costs[arc] = network->getCost(arc);
+            max_abs_cost = std::max<types::accumulator_t>(max_abs_cost, costs[arc] < 0 ? -static_cast<types::accumulator_t>(costs[arc]) : costs[arc]);
+        }
+        const auto& capacities = network->getResidualCapacities();
+
+        // layout of the segment
+        const void* data[NumSections] {
+            first_arc.data(), tails.data(), heads.data(), twins.data(), forward.data(), costs.data(), capacities.data(),
+            edge_sources.data(), edge_sinks.data(), edge_capacities.data(), edge_costs.data(), edge_arcs.data()
+        };
+        Header header {};
+        std::memcpy(header.magic, snapshot_magic, sizeof(header.magic));
+        header.version = snapshot_version;
+        header.capacity_bytes = sizeof(types::capacity_t);
+        header.cost_bytes = sizeof(types::cost_t);
+        header.num_nodes = num_nodes;
+        header.num_arcs = num_arcs;
+        header.num_edges = static_cast<std::int32_t>(edge_sources.size());
+        header.unit_capacities = unit_capacities;
+        header.max_abs_cost = max_abs_cost;
+        header.lengths[FirstArc] = first_arc.size() * sizeof(int);
+        header.lengths[Tails] = tails.size() * sizeof(int);
+        header.lengths[Heads] = heads.size() * sizeof(int);
+        header.lengths[Twins] = twins.size() * sizeof(int);
+        header.lengths[Forward] = forward.size() * sizeof(std::uint8_t);
+        header.lengths[Costs] = costs.size() * sizeof(types::cost_t);
+        header.lengths[Capacities] = capacities.size() * sizeof(types::capacity_t);
+        header.lengths[EdgeSources] = edge_sources.size() * sizeof(int);
+        header.lengths[EdgeSinks] = edge_sinks.size() * sizeof(int);
+        header.lengths[EdgeCapacities] = edge_capacities.size() * sizeof(types::capacity_t);
+        header.lengths[EdgeCosts] = edge_costs.size() * sizeof(types::cost_t);
+        header.lengths[EdgeArcs] = edge_arcs.size() * sizeof(int);
+
+        std::uint64_t offset { align(sizeof(Header)) };
+        for (int section = 0; section < NumSections; section++) {
+            header.offsets[section] = offset;
+            offset = align(offset + header.lengths[section]);
+        }
+        header.size = offset;
+
+        // a new segment: the processes attached to the old one keep it
+        ::shm_unlink(name.c_str());
+        int fd { ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644) };
+        if (fd == -1) {
+            throw std::runtime_error(errorMessage("Cannot create the snapshot", name));
+        }
+        if (::ftruncate(fd, static_cast<off_t>(header.size)) == -1) {
+            std::string message { errorMessage("Cannot allocate the snapshot", name) };
+            ::close(fd);
+            ::shm_unlink(name.c_str());
+            throw std::runtime_error(message);
+        }
+        void* address { ::mmap(nullptr, header.size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) };
+        ::close(fd);
+        if (address == MAP_FAILED) {
+            std::string message { errorMessage("Cannot map the snapshot", name) };
+            ::shm_unlink(name.c_str());
+            throw std::runtime_error(message);
+        }
+
+        auto* bytes = static_cast<char*>(address);
+        for (int section = 0; section < NumSections; section++) {
+            if (header.lengths[section] > 0) {
+                std::memcpy(bytes + header.offsets[section], data[section], header.lengths[section]);
+            }
+        }
+        std::memcpy(bytes, &header, sizeof(Header));
+
+        // the attached processes see the flag only after the arrays
+        std::atomic_thread_fence(std::memory_order_release);
+        reinterpret_cast<Header*>(bytes)->complete = 1;
+        ::munmap(address, header.size);
+
+        return header.size;
+    }
+
+    std::shared_ptr<GraphSnapshot> GraphSnapshot::Attach(const std::string& name) {
+        int fd { ::shm_open(name.c_str(), O_RDONLY, 0) };
+        if (fd == -1) {
+            throw std::runtime_error(errorMessage("Cannot open the snapshot", name));
+        }
+
+        struct stat status {};
+        if (::fstat(fd, &status) == -1 || static_cast<std::size_t>(status.st_size) < sizeof(Header)) {
+            ::close(fd);
+            throw std::runtime_error("The snapshot " + name + " is not valid");
+        }
+        auto size = static_cast<std::size_t>(status.st_size);
+
+        void* address { ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0) };
+        ::close(fd);
+        if (address == MAP_FAILED) {
+            throw std::runtime_error(errorMessage("Cannot map the snapshot", name));
+        }
+
+        try {
+            return std::shared_ptr<GraphSnapshot>(new GraphSnapshot(address, size));
+        } catch (...) {
+            ::munmap(address, size);
+            throw;
+        }
+    }
+
+    void GraphSnapshot::Unlink(const std::string& name) {
+        if (::shm_unlink(name.c_str()) == -1) {
+            throw std::runtime_error(errorMessage("Cannot remove the snapshot", name));
+        }
+    }
+
+    GraphSnapshot::GraphSnapshot(const void* address, std::size_t size) : address(address), size(size) {
+        const auto* bytes = static_cast<const char*>(address);
+        Header header {};
+        std::memcpy(&header, bytes, sizeof(Header));
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if (std::memcmp(header.magic, snapshot_magic, sizeof(header.magic)) != 0 || header.version != snapshot_version
+            || header.complete != 1 || header.size != size) {
+            throw std::runtime_error("The shared memory segment is not a complete snapshot");
+        }
+        if (header.capacity_bytes != sizeof(types::capacity_t) || header.cost_bytes != sizeof(types::cost_t)) {
+            throw std::runtime_error("The snapshot was written with different capacity and cost types");
+        }
+
+        // every array must have the expected length and lie inside the segment
+        std::uint64_t num_nodes_length { static_cast<std::uint64_t>(header.num_nodes) + 1 };
+        std::uint64_t expected[NumSections] {
+            num_nodes_length * sizeof(int), header.num_arcs * sizeof(int), header.num_arcs * sizeof(int), header.num_arcs * sizeof(int),
+            header.num_arcs * sizeof(std::uint8_t), header.num_arcs * sizeof(types::cost_t), header.num_arcs * sizeof(types::capacity_t),
+            header.num_edges * sizeof(int), header.num_edges * sizeof(int), header.num_edges * sizeof(types::capacity_t),
+            header.num_edges * sizeof(types::cost_t), header.num_edges * sizeof(int)
+        };
+        if (header.num_nodes < 0 || header.num_arcs < 0 || header.num_edges < 0) {
+            throw std::runtime_error("The snapshot is not valid");
+        }
+        for (int section = 0; section < NumSections; section++) {
+            if (header.lengths[section] != expected[section] || header.offsets[section] % section_alignment != 0
+                || header.offsets[section] > size || header.lengths[section] > size - header.offsets[section]) {
+                throw std::runtime_error("The snapshot is not valid");
+            }
+        }
+
+        auto array = [&](Section section) { return static_cast<const void*>(bytes + header.offsets[section]); };
+        this->num_nodes = header.num_nodes;
+        this->num_arcs = header.num_arcs;
+        this->num_edges = header.num_edges;
+        this->unit_capacities = header.unit_capacities != 0;
+        this->max_abs_cost = header.max_abs_cost;
+        this->first_arc = static_cast<const int*>(array(FirstArc));
+        this->tails = static_cast<const int*>(array(Tails));
+        this->heads = static_cast<const int*>(array(Heads));
+        this->twins = static_cast<const int*>(array(Twins));
+        this->forward = static_cast<const std::uint8_t*>(array(Forward));
+        this->costs = static_cast<const types::cost_t*>(array(Costs));
+        this->capacities = static_cast<const types::capacity_t*>(array(Capacities));
+        this->edge_sources = static_cast<const int*>(array(EdgeSources));
+        this->edge_sinks = static_cast<const int*>(array(EdgeSinks));
+        this->edge_capacities = static_cast<const types::capacity_t*>(array(EdgeCapacities));
+        this->edge_costs = static_cast<const types::cost_t*>(array(EdgeCosts));
+        this->edge_arcs = static_cast<const int*>(array(EdgeArcs));
+    }
+
+    GraphSnapshot::~GraphSnapshot() {
+        ::munmap(const_cast<void*>(this->address), this->size);
+    }
+
+    std::shared_ptr<Graph> GraphSnapshot::toGraph() const {
+        auto graph = std::make_shared<Graph>(this->num_nodes);
+        for (int edge = 0; edge < this->num_edges; edge++) {
+            graph->addEdge(this->edge_sources[edge], this->edge_sinks[edge], this->edge_capacities[edge], this->edge_costs[edge]);
+        }
+
+        return graph;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,220 @@
+#ifndef MINIMUM_COST_FLOWS_PROBLEM_GRAPHSNAPSHOT_H
+#define MINIMUM_COST_FLOWS_PROBLEM_GRAPHSNAPSHOT_H
+
+#include "types/Types.h"
+#include "data_structures/graph/Graph.h"
+
+#include <memory>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+namespace data_structures {
+    class ResidualNetwork;
+
+    /**
+     * Read-only snapshot of a graph in POSIX shared memory, so that the processes solving the same graph
+     * share a single copy of it instead of holding one each.
+     * A process publishes the graph once, the others attach to the snapshot (the segment is mapped read-only)
+     * and build their residual networks on it (see ResidualNetwork(const std::shared_ptr<GraphSnapshot>&)):
+     * each of them allocates only the residual capacities and the node potentials.
+     *
+     * The segment contains a header followed by arrays at offsets from its start (no pointers), so it can be
+     * mapped at any address:
+     *  - the arrays of the residual network without flow (CSR offsets, tails, heads, twins, directions,
+     *    costs and capacities, see ResidualNetwork)
+     *  - the edges of the input graph in the order of the adjacency lists, with the forward arc carrying
+     *    the flow of each of them (see utils::GraphUtils::GetEdgeFlows()).
+     * The header is marked complete only after the arrays are written, an incomplete or incompatible
+     * segment (e.g. written with NETWORK_FLOWS_COMPACT_WEIGHTS by another build) cannot be attached.
+     */
+    class GraphSnapshot {
+        public:
+            /**
+             * Publish a graph as a snapshot, replacing the snapshot with the same name if there is one
+             * (the processes attached to it keep the old one until they detach).
+             * The snapshot stays in the shared memory until it is unlinked (see Unlink()).
+             *
+             * E: number of edges
+             * V: number of nodes
+             * Time complexity: O(V + E)
+             *
+             * @param name    the name of the snapshot (a POSIX shared memory name, e.g. "/graph")
+             * @param graph   the graph
+             * @param network the residual network of the graph, without flow
+             *
+             * @return the size of the snapshot in bytes
+             *
+             * @throws runtime_error if the shared memory cannot be created
+             */
+            static std::size_t Publish(const std::string& name, const std::shared_ptr<Graph>& graph,
+                const std::shared_ptr<ResidualNetwork>& network);
+
+            /**
+             * Attach to a snapshot, mapping it read-only.
+             *
+             * Time complexity: O(1)
+             *
+             * @param name the name of the snapshot
+             *
+             * @return the snapshot, the mapping is removed when it is destroyed
+             *
+             * @throws runtime_error if the snapshot does not exist or is not valid
+             */
+            static std::shared_ptr<GraphSnapshot> Attach(const std::string& name);
+
+            /**
+             * Remove a snapshot from the shared memory, the processes attached to it keep it until they detach.
+             *
+             * @param name the name of the snapshot
+             *
+             * @throws runtime_error if the snapshot does not exist
+             */
+            static void Unlink(const std::string& name);
+
+            /**
+             * Detach from the snapshot.
+             */
+            ~GraphSnapshot();
+
+            GraphSnapshot(const GraphSnapshot&) = delete;
+            GraphSnapshot& operator=(const GraphSnapshot&) = delete;
+
+            /**
+             * Get the number of nodes.
+             *
+             * @return the number of nodes
+             */
+            [[nodiscard]] int getNumNodes() const { return this->num_nodes; }
+
+            /**
+             * Get the number of arcs of the residual network.
+             *
+             * @return the number of arcs
+             */
+            [[nodiscard]] int getNumArcs() const { return this->num_arcs; }
+
+            /**
+             * Get the number of edges of the input graph.
+             *
+             * @return the number of edges
+             */
+            [[nodiscard]] int getNumEdges() const { return this->num_edges; }
+
+            /**
+             * Get the size of the snapshot.
+             *
+             * @return the size in bytes
+             */
+            [[nodiscard]] std::size_t getSize() const { return this->size; }
+
+            /**
+             * Check if every edge of the graph has capacity 1 (see utils::GraphUtils::HasUnitCapacities()).
+             *
+             * @return true if every edge has capacity 1, false otherwise
+             */
+            [[nodiscard]] bool hasUnitCapacities() const { return this->unit_capacities; }
+
+            /**
+             * Get the maximum absolute value of the costs.
+             *
+             * @return the maximum absolute value of the costs
+             */
+            [[nodiscard]] types::accumulator_t getMaxAbsCost() const { return this->max_abs_cost; }
+
+            // arrays of the residual network without flow (see ResidualNetwork)
+            [[nodiscard]] const int* getFirstArcs() const { return this->first_arc; }
+            [[nodiscard]] const int* getTails() const { return this->tails; }
+            [[nodiscard]] const int* getHeads() const { return this->heads; }
+            [[nodiscard]] const int* getTwins() const { return this->twins; }
+            [[nodiscard]] const std::uint8_t* getForward() const { return this->forward; }
+            [[nodiscard]] const types::cost_t* getCosts() const { return this->costs; }
+            [[nodiscard]] const types::capacity_t* getCapacities() const { return this->capacities; }
+
+            /**
+             * Get the forward arc carrying the flow of an edge of the input graph.
+             *
+             * @param edge the index of the edge, in the order of the adjacency lists
+             *
+             * @return the arc
+             */
+            [[nodiscard]] int getEdgeArc(int edge) const { return this->edge_arcs[edge]; }
+
+            /**
+             * Get the source of an edge of the input graph.
+             *
+             * @param edge the index of the edge, in the order of the adjacency lists
+             *
+             * @return the source node
+             */
+            [[nodiscard]] int getEdgeSource(int edge) const { return this->edge_sources[edge]; }
+
+            /**
+             * Get the sink of an edge of the input graph.
+             *
+             * @param edge the index of the edge, in the order of the adjacency lists
+             *
+             * @return the sink node
+             */
+            [[nodiscard]] int getEdgeSink(int edge) const { return this->edge_sinks[edge]; }
+
+            /**
+             * Get the cost of an edge of the input graph.
+             *
+             * @param edge the index of the edge, in the order of the adjacency lists
+             *
+             * @return the cost
+             */
+            [[nodiscard]] types::cost_t getEdgeCost(int edge) const { return this->edge_costs[edge]; }
+
+            /**
+             * Build a private copy of the input graph (e.g. to write the solutions, see utils::FlowWriter).
+             *
+             * E: number of edges
+             * D: maximum out-degree
+             * Time complexity: O(E * D)
+             *
+             * @return the input graph
+             */
+            [[nodiscard]] std::shared_ptr<Graph> toGraph() const;
+
+        private:
+            /**
+             * Read the header and the arrays of a mapped segment.
+             *
+             * @param address the address of the mapping
+             * @param size    the size of the mapping
+             *
+             * @throws runtime_error if the segment is not a valid snapshot
+             */
+            GraphSnapshot(const void* address, std::size_t size);
+
+            // mapping
+            const void* address;
+            std::size_t size;
+
+            int num_nodes;
+            int num_arcs;
+            int num_edges;
+            bool unit_capacities;
+            types::accumulator_t max_abs_cost;
+
+            // arrays of the residual network
+            const int* first_arc;
+            const int* tails;
+            const int* heads;
+            const int* twins;
+            const std::uint8_t* forward;
+            const types::cost_t* costs;
+            const types::capacity_t* capacities;
+
+            // edges of the input graph
+            const int* edge_sources;
+            const int* edge_sinks;
+            const types::capacity_t* edge_capacities;
+            const types::cost_t* edge_costs;
+            const int* edge_arcs;
+    };
+}
+
+#endif //MINIMUM_COST_FLOWS_PROBLEM_GRAPHSNAPSHOT_H
@@ -0,0 +1,29 @@
+#include "BfsWorkspace.h"
+
+#include <algorithm>
+
+namespace data_structures {
+    BfsWorkspace::BfsWorkspace(int num_nodes) :
+        generation(0),
+        forward_stamp(num_nodes, 0),
+        backward_stamp(num_nodes, 0),
+        forward_parent_arc(num_nodes, -1),
+        backward_parent_arc(num_nodes, -1),
+        meeting_node(-1) {}
+
+    void BfsWorkspace::reset() {
+        this->generation++;
+
+        // the stamps of old searches could match the generation again
+        if (this->generation == 0) {
+            std::fill(this->forward_stamp.begin(), this->forward_stamp.end(), 0);
+            std::fill(this->backward_stamp.begin(), this->backward_stamp.end(), 0);
+            this->generation = 1;
+        }
+
+        this->meeting_node = -1;
+        this->forward_frontier.clear();
+        this->backward_frontier.clear();
+        this->next_frontier.clear();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,155 @@
+#ifndef MINIMUM_COST_FLOWS_PROBLEM_BFSWORKSPACE_H
+#define MINIMUM_COST_FLOWS_PROBLEM_BFSWORKSPACE_H
+
+#include <vector>
+#include <cstdint>
+
+namespace data_structures {
+    /**
+     * Class containing the buffers of a (bidirectional) breadth-first search on a residual network,
+     * reused by the searches of an algorithm instead of being allocated at every search.
+     * A node is visited by a side of the search if its stamp is equal to the current generation:
+     * starting a new search only increments the generation, so it costs O(1) instead of O(V).
+     * For each visited node it keeps the arc used to reach it:
+     *  - forward side (from the source): the arc parent -> node
+     *  - backward side (from the sink): the arc node -> parent, i.e. the next arc towards the sink.
+     */
+    class BfsWorkspace {
+        public:
+            /**
+             * Build the workspace of a network.
+             *
+             * @param num_nodes the number of nodes of the network
+             */
+            explicit BfsWorkspace(int num_nodes);
+
+            /**
+             * Start a new search: every node becomes not visited and the frontiers are cleared.
+             *
+             * Time complexity: O(1) (O(V) every 2^32 searches, when the generation wraps around)
+             */
+            void reset();
+
+            /**
+             * Get the number of nodes.
+             *
+             * @return the number of nodes
+             */
+            [[nodiscard]] int getNumNodes() const { return static_cast<int>(this->forward_stamp.size()); }
+
+            /**
+             * Check if the node was visited by the forward side of the current search.
+             *
+             * @param node the node
+             *
+             * @return true if the node was visited, false otherwise
+             */
+            [[nodiscard]] bool isForwardVisited(int node) const { return this->forward_stamp[node] == this->generation; }
+
+            /**
+             * Check if the node was visited by the backward side of the current search.
+             *
+             * @param node the node
+             *
+             * @return true if the node was visited, false otherwise
+             */
+            [[nodiscard]] bool isBackwardVisited(int node) const { return this->backward_stamp[node] == this->generation; }
+
+            /**
+             * Mark the node as visited by the forward side of the current search.
+             *
+             * @param node       the node
+             * @param parent_arc the arc parent -> node (-1 for the source)
+             */
+            void visitForward(int node, int parent_arc) {
+                this->forward_stamp[node] = this->generation;
+                this->forward_parent_arc[node] = parent_arc;
+            }
+
+            /**
+             * Mark the node as visited by the backward side of the current search.
+             *
+             * @param node       the node
+             * @param parent_arc the arc node -> parent (-1 for the sink)
+             */
+            void visitBackward(int node, int parent_arc) {
+                this->backward_stamp[node] = this->generation;
+                this->backward_parent_arc[node] = parent_arc;
+            }
+
+            /**
+             * Get the arc used by the forward side to reach the node.
+             *
+             * @param node the node, visited by the forward side
+             *
+             * @return the arc parent -> node
+             */
+            [[nodiscard]] int getForwardParentArc(int node) const { return this->forward_parent_arc[node]; }
+
+            /**
+             * Get the arc used by the backward side to reach the node.
+             *
+             * @param node the node, visited by the backward side
+             *
+             * @return the arc node -> parent
+             */
+            [[nodiscard]] int getBackwardParentArc(int node) const { return this->backward_parent_arc[node]; }
+
+            /**
+             * Get the node where the two sides of the last search met.
+             *
+             * @return the meeting node (-1 if the sides did not meet)
+             */
+            [[nodiscard]] int getMeetingNode() const { return this->meeting_node; }
+
+            /**
+             * Set the node where the two sides of the search met.
+             *
+             * @param node the meeting node
+             */
+            void setMeetingNode(int node) { this->meeting_node = node; }
+
+            /**
+             * Get the frontier of the forward side.
+             *
+             * @return the frontier of the forward side
+             */
+            [[nodiscard]] std::vector<int>& getForwardFrontier() { return this->forward_frontier; }
+
+            /**
+             * Get the frontier of the backward side.
+             *
+             * @return the frontier of the backward side
+             */
+            [[nodiscard]] std::vector<int>& getBackwardFrontier() { return this->backward_frontier; }
+
+            /**
+             * Get the buffer used to build the next frontier.
+             *
+             * @return the next frontier
+             */
+            [[nodiscard]] std::vector<int>& getNextFrontier() { return this->next_frontier; }
+
+        private:
+            // generation of the current search
+            std::uint32_t generation;
+
+            // generation of the last search that visited each node
+            std::vector<std::uint32_t> forward_stamp;
+            std::vector<std::uint32_t> backward_stamp;
+
+            // arc used to reach each node
+            std::vector<int> forward_parent_arc;
+            std::vector<int> backward_parent_arc;
+
+            // node where the two sides met
+            int meeting_node;
+
+            // frontiers of the two sides and buffer for the next frontier
+            std::vector<int> forward_frontier;
+            std::vector<int> backward_frontier;
+            std::vector<int> next_frontier;
+    };
+}
+
+#endif //MINIMUM_COST_FLOWS_PROBLEM_BFSWORKSPACE_H
@@ -0,0 +1,26 @@
+#include "DijkstraWorkspace.h"
+
+#include <algorithm>
+
+namespace data_structures {
+    DijkstraWorkspace::DijkstraWorkspace(int num_nodes) :
+        generation(0),
+        reached_stamp(num_nodes, 0),
+        settled_stamp(num_nodes, 0),
+        distance(num_nodes, 0),
+        parent_arc(num_nodes, -1) {}
+
+    void DijkstraWorkspace::reset() {
+        this->generation++;
+
+        // the stamps of old searches could match the generation again
+        if (this->generation == 0) {
+            std::fill(this->reached_stamp.begin(), this->reached_stamp.end(), 0);
+            std::fill(this->settled_stamp.begin(), this->settled_stamp.end(), 0);
+            this->generation = 1;
+        }
+
+        this->settled_nodes.clear();
+        this->queue.clear();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,140 @@
+#ifndef MINIMUM_COST_FLOWS_PROBLEM_DIJKSTRAWORKSPACE_H
+#define MINIMUM_COST_FLOWS_PROBLEM_DIJKSTRAWORKSPACE_H
+
+#include "types/Types.h"
+
+#include <vector>
+#include <cstdint>
+#include <utility>
+
+namespace data_structures {
+    /**
+     * Class containing the buffers of a Dijkstra search on a residual network, reused by the searches
+     * of an algorithm instead of being allocated at every search (as BfsWorkspace).
+     * A node is reached (it has a tentative distance) if its stamp is equal to the current generation,
+     * so starting a new search costs O(1) and the distances of the nodes not reached are never reset.
+     * The settled nodes are also kept in the order they are settled, so the work after a search
+     * (e.g. ResidualNetwork::updatePotentials()) is proportional to the nodes it settled.
+     */
+    class DijkstraWorkspace {
+        public:
+            /**
+             * Entry of the priority queue: (distance, node).
+             */
+            using QueueEntry = std::pair<types::accumulator_t, int>;
+
+            /**
+             * Build the workspace of a network.
+             *
+             * @param num_nodes the number of nodes of the network
+             */
+            explicit DijkstraWorkspace(int num_nodes);
+
+            /**
+             * Start a new search: every node becomes not reached and the settled nodes and the queue are cleared.
+             *
+             * Time complexity: O(1) (O(V) every 2^32 searches, when the generation wraps around)
+             */
+            void reset();
+
+            /**
+             * Get the number of nodes.
+             *
+             * @return the number of nodes
+             */
+            [[nodiscard]] int getNumNodes() const { return static_cast<int>(this->reached_stamp.size()); }
+
+            /**
+             * Check if the node was reached by the current search.
+             *
+             * @param node the node
+             *
+             * @return true if the node has a tentative distance, false otherwise
+             */
+            [[nodiscard]] bool isReached(int node) const { return this->reached_stamp[node] == this->generation; }
+
+            /**
+             * Check if the node was settled by the current search (its distance is final).
+             *
+             * @param node the node
+             *
+             * @return true if the node was settled, false otherwise
+             */
+            [[nodiscard]] bool isSettled(int node) const { return this->settled_stamp[node] == this->generation; }
+
+            /**
+             * Get the distance of the node.
+             *
+             * @param node the node, reached by the current search
+             *
+             * @return the (tentative if not settled) distance of the node
+             */
+            [[nodiscard]] types::accumulator_t getDistance(int node) const { return this->distance[node]; }
+
+            /**
+             * Get the arc used to reach the node.
+             *
+             * @param node the node, reached by the current search
+             *
+             * @return the arc parent -> node (-1 for the source)
+             */
+            [[nodiscard]] int getParentArc(int node) const { return this->parent_arc[node]; }
+
+            /**
+             * Set the tentative distance of the node and mark it as reached.
+             *
+             * @param node       the node
+             * @param distance   the distance of the node
+             * @param parent_arc the arc parent -> node (-1 for the source)
+             */
+            void reach(int node, types::accumulator_t distance, int parent_arc) {
+                this->reached_stamp[node] = this->generation;
+                this->distance[node] = distance;
+                this->parent_arc[node] = parent_arc;
+            }
+
+            /**
+             * Mark the node as settled.
+             *
+             * @param node the node, reached by the current search
+             */
+            void settle(int node) {
+                this->settled_stamp[node] = this->generation;
+                this->settled_nodes.push_back(node);
+            }
+
+            /**
+             * Get the nodes settled by the current search, in the order they were settled.
+             *
+             * @return the settled nodes
+             */
+            [[nodiscard]] const std::vector<int>& getSettledNodes() const { return this->settled_nodes; }
+
+            /**
+             * Get the buffer of the priority queue (a binary heap managed with std::push_heap() and std::pop_heap()).
+             *
+             * @return the priority queue
+             */
+            [[nodiscard]] std::vector<QueueEntry>& getQueue() { return this->queue; }
+
+        private:
+            // generation of the current search
+            std::uint32_t generation;
+
+            // generation of the last search that reached and settled each node
+            std::vector<std::uint32_t> reached_stamp;
+            std::vector<std::uint32_t> settled_stamp;
+
+            // distance and arc used to reach each node (valid only for the reached nodes)
+            std::vector<types::accumulator_t> distance;
+            std::vector<int> parent_arc;
+
+            // nodes settled by the current search
+            std::vector<int> settled_nodes;
+
+            // priority queue of the search
+            std::vector<QueueEntry> queue;
+    };
+}
+
+#endif //MINIMUM_COST_FLOWS_PROBLEM_DIJKSTRAWORKSPACE_H
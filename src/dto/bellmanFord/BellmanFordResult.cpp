@@ -5,11 +5,11 @@
 namespace dto {
     BellmanFordResult::BellmanFordResult(std::shared_ptr<std::vector<int>> negative_cycle) :
         negative_cycle(std::move(negative_cycle)) {
-            this->distance = std::make_shared<std::vector<int>>();
+            this->distance = std::make_shared<std::vector<types::accumulator_t>>();
             this->parent = std::make_shared<std::vector<int>>();
     }
 
-    BellmanFordResult::BellmanFordResult(std::shared_ptr<std::vector<int>> distance, std::shared_ptr<std::vector<int>> parent) :
+    BellmanFordResult::BellmanFordResult(std::shared_ptr<std::vector<types::accumulator_t>> distance, std::shared_ptr<std::vector<int>> parent) :
         parent(std::move(parent)),
         distance(std::move(distance)) {
             this->negative_cycle = std::make_shared<std::vector<int>>();
@@ -23,7 +23,7 @@ namespace dto {
         return this->negative_cycle;
     }
 
-    [[maybe_unused]] std::shared_ptr<std::vector<int>> BellmanFordResult::getDistance() {
+    [[maybe_unused]] std::shared_ptr<std::vector<types::accumulator_t>> BellmanFordResult::getDistance() {
         return this->distance;
     }
 
@@ -1,6 +1,8 @@
 #ifndef MINIMUM_COST_FLOWS_PROBLEM_BELLMANFORDRESULT_H
 #define MINIMUM_COST_FLOWS_PROBLEM_BELLMANFORDRESULT_H
 
+#include "types/Types.h"
+
 #include <vector>
 #include <memory>
 
@@ -28,7 +30,7 @@ namespace dto {
          * @param distance the distance of each vertex from the source node
          * @param parent   the parent of each node
          */
-        BellmanFordResult(std::shared_ptr<std::vector<int>> distance, std::shared_ptr<std::vector<int>> parent);
+        BellmanFordResult(std::shared_ptr<std::vector<types::accumulator_t>> distance, std::shared_ptr<std::vector<int>> parent);
 
         /**
          * Returns true if the graph contains a negative cycle.
@@ -51,7 +53,7 @@ namespace dto {
          * 
          * @return the distance of each vertex from the source vertex
          */
-        [[maybe_unused]] std::shared_ptr<std::vector<int>> getDistance();
+        [[maybe_unused]] std::shared_ptr<std::vector<types::accumulator_t>> getDistance();
 
         /**
          * Returns the parent of each vertex.
@@ -63,7 +65,7 @@ namespace dto {
         
     private:
         std::shared_ptr<std::vector<int>> parent;
-        std::shared_ptr<std::vector<int>> distance;
+        std::shared_ptr<std::vector<types::accumulator_t>> distance;
         std::shared_ptr<std::vector<int>> negative_cycle;
     };
 }
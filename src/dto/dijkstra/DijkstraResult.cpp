@@ -4,15 +4,27 @@
 #include <utility>
 
 namespace dto {
-    DijkstraResult::DijkstraResult(std::shared_ptr<std::vector<int>> distance, std::shared_ptr<std::vector<int>> parent) :
+    DijkstraResult::DijkstraResult(std::shared_ptr<std::vector<types::accumulator_t>> distance, std::shared_ptr<std::vector<int>> parent) :
         parent(std::move(parent)),
-        distance(std::move(distance)) {}
+        distance(std::move(distance)) {
+            this->parent_arc = std::make_shared<std::vector<int>>();
+    }
+
+    DijkstraResult::DijkstraResult(std::shared_ptr<std::vector<types::accumulator_t>> distance, std::shared_ptr<std::vector<int>> parent,
+        std::shared_ptr<std::vector<int>> parent_arc) :
+        parent(std::move(parent)),
+        distance(std::move(distance)),
+        parent_arc(std::move(parent_arc)) {}
 
-    [[maybe_unused]] std::shared_ptr<std::vector<int>> DijkstraResult::getDistance() {
+    [[maybe_unused]] std::shared_ptr<std::vector<types::accumulator_t>> DijkstraResult::getDistance() {
         return this->distance;
     }
 
     [[maybe_unused]] std::shared_ptr<std::vector<int>> DijkstraResult::getParent() {
         return this->parent;
     }
+
+    [[maybe_unused]] std::shared_ptr<std::vector<int>> DijkstraResult::getParentArc() {
+        return this->parent_arc;
+    }
 } 
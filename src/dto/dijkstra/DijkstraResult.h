@@ -1,6 +1,8 @@
 #ifndef MINIMUM_COST_FLOWS_PROBLEM_DIJKSTRARESULT_H
 #define MINIMUM_COST_FLOWS_PROBLEM_DIJKSTRARESULT_H
 
+#include "types/Types.h"
+
 #include <vector>
 #include <memory>
 
@@ -17,14 +19,24 @@ namespace dto {
          * @param distance the distance of each vertex from the source node
          * @param parent   the parent of each node
          */
-        DijkstraResult(std::shared_ptr<std::vector<int>> distance, std::shared_ptr<std::vector<int>> parent);
+        DijkstraResult(std::shared_ptr<std::vector<types::accumulator_t>> distance, std::shared_ptr<std::vector<int>> parent);
+
+        /**
+         * Dijkstra result constructor for the algorithm applied to a residual network.
+         * 
+         * @param distance   the distance of each vertex from the source node
+         * @param parent     the parent of each node
+         * @param parent_arc the arc used to reach each node (-1 for the source and the unreachable nodes)
+         */
+        DijkstraResult(std::shared_ptr<std::vector<types::accumulator_t>> distance, std::shared_ptr<std::vector<int>> parent,
+            std::shared_ptr<std::vector<int>> parent_arc);
 
         /**
          * Returns the distance of each vertex from the source vertex.
          * 
          * @return the distance of each vertex from the source vertex
          */
-        [[maybe_unused]] std::shared_ptr<std::vector<int>> getDistance();
+        [[maybe_unused]] std::shared_ptr<std::vector<types::accumulator_t>> getDistance();
 
         /**
          * Returns the parent of each vertex.
@@ -32,10 +44,19 @@ namespace dto {
          * @return the the parent of each vertex
          */
         [[maybe_unused]] std::shared_ptr<std::vector<int>> getParent();
+
+        /**
+         * Returns the arc used to reach each vertex.
+         * If the algorithm was not applied to a residual network, returns an empty vector.
+         * 
+         * @return the arc used to reach each vertex
+         */
+        [[maybe_unused]] std::shared_ptr<std::vector<int>> getParentArc();
         
     private:
         std::shared_ptr<std::vector<int>> parent;
-        std::shared_ptr<std::vector<int>> distance;
+        std::shared_ptr<std::vector<types::accumulator_t>> distance;
+        std::shared_ptr<std::vector<int>> parent_arc;
     };
 }
 
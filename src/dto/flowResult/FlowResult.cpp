@@ -3,15 +3,40 @@
 #include <utility>
 
 namespace dto {
-    FlowResult::FlowResult(std::shared_ptr<data_structures::Graph> graph, int flow) :
+    FlowResult::FlowResult(std::shared_ptr<data_structures::Graph> graph, std::shared_ptr<std::vector<types::capacity_t>> edge_flows,
+        types::accumulator_t flow) :
         flow(flow),
-        graph(std::move(graph)) {}
+        graph(std::move(graph)),
+        edge_flows(std::move(edge_flows)) {}
+
+    FlowResult::FlowResult(std::shared_ptr<data_structures::Graph> graph, std::shared_ptr<std::vector<types::capacity_t>> edge_flows,
+        types::accumulator_t flow, std::shared_ptr<MinCut> min_cut) :
+        flow(flow),
+        graph(std::move(graph)),
+        edge_flows(std::move(edge_flows)),
+        min_cut(std::move(min_cut)) {}
 
     std::shared_ptr<data_structures::Graph> FlowResult::getGraph() const {
         return this->graph;
     }
 
-    int FlowResult::getFlow() const {
+    std::shared_ptr<std::vector<types::capacity_t>> FlowResult::getEdgeFlows() const {
+        return this->edge_flows;
+    }
+
+    types::accumulator_t FlowResult::getFlow() const {
         return this->flow;
     }
+
+    std::shared_ptr<MinCut> FlowResult::getMinCut() const {
+        return this->min_cut;
+    }
+
+    std::shared_ptr<SolverStats> FlowResult::getStats() const {
+        return this->stats;
+    }
+
+    void FlowResult::setStats(std::shared_ptr<SolverStats> stats) {
+        this->stats = std::move(stats);
+    }
 }
\ No newline at end of file
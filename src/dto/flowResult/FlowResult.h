@@ -1,22 +1,42 @@
 #ifndef MINIMUM_COST_FLOWS_PROBLEM_EDMONDSKARPRESULT_H
 #define MINIMUM_COST_FLOWS_PROBLEM_EDMONDSKARPRESULT_H
 
+#include "types/Types.h"
 #include "data_structures/graph/Graph.h"
+#include "dto/minCut/MinCut.h"
+#include "dto/solverStats/SolverStats.h"
+
+#include <vector>
+#include <memory>
 
 namespace dto {
     /**
      * Class that represents the result of the flow's algorithms.
-     * It contains the graph and the flow.
+     * It contains the graph, the flow of each edge of the input graph (see utils::GraphUtils::GetEdgeFlows()) and the flow,
+     * and for the maximum flow algorithms the minimum cut.
      */
     class FlowResult {
     public:
         /**
          * Constructor.
          *
-         * @param graph    the graph
-         * @param flow     the flow
+         * @param graph      the graph
+         * @param edge_flows the flow of each edge of the input graph
+         * @param flow       the flow
+         */
+        FlowResult(std::shared_ptr<data_structures::Graph> graph, std::shared_ptr<std::vector<types::capacity_t>> edge_flows,
+            types::accumulator_t flow);
+
+        /**
+         * Constructor for the maximum flow algorithms.
+         *
+         * @param graph      the graph
+         * @param edge_flows the flow of each edge of the input graph
+         * @param flow       the flow
+         * @param min_cut    the minimum cut
          */
-        FlowResult(std::shared_ptr<data_structures::Graph> graph, int flow);
+        FlowResult(std::shared_ptr<data_structures::Graph> graph, std::shared_ptr<std::vector<types::capacity_t>> edge_flows,
+            types::accumulator_t flow, std::shared_ptr<MinCut> min_cut);
 
         /**
          * Getter for the graph.
@@ -25,16 +45,47 @@ namespace dto {
          */
         [[nodiscard]] std::shared_ptr<data_structures::Graph> getGraph() const;
 
+        /**
+         * Getter for the flow of each edge.
+         *
+         * @return the flow of each edge of the input graph, indexed as its edges (see utils::FlowWriter)
+         */
+        [[nodiscard]] std::shared_ptr<std::vector<types::capacity_t>> getEdgeFlows() const;
+
         /**
          * Getter for the flow.
          *
          * @return the flow
          */
-        [[nodiscard]] int getFlow() const;
+        [[nodiscard]] types::accumulator_t getFlow() const;
+
+        /**
+         * Getter for the minimum cut.
+         *
+         * @return the minimum cut (nullptr if the algorithm does not compute it)
+         */
+        [[nodiscard]] std::shared_ptr<MinCut> getMinCut() const;
+
+        /**
+         * Getter for the statistics of the run.
+         *
+         * @return the statistics (nullptr if the project is not built with NETWORK_FLOWS_STATS, see utils::Stats)
+         */
+        [[nodiscard]] std::shared_ptr<SolverStats> getStats() const;
+
+        /**
+         * Setter for the statistics of the run.
+         *
+         * @param stats the statistics
+         */
+        void setStats(std::shared_ptr<SolverStats> stats);
 
     private:
-        int flow;
+        types::accumulator_t flow;
         std::shared_ptr<data_structures::Graph> graph;
+        std::shared_ptr<std::vector<types::capacity_t>> edge_flows;
+        std::shared_ptr<MinCut> min_cut;
+        std::shared_ptr<SolverStats> stats;
     };
 }
 
@@ -0,0 +1,71 @@
+#include "GomoryHuTree.h"
+
+#include <limits>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+
+namespace dto {
+    GomoryHuTree::GomoryHuTree(std::shared_ptr<std::vector<int>> parent, std::shared_ptr<std::vector<types::accumulator_t>> weight) :
+        parent(std::move(parent)),
+        weight(std::move(weight)) {
+
+        int num_nodes { static_cast<int>(this->parent->size()) };
+        if (static_cast<int>(this->weight->size()) != num_nodes || (num_nodes > 0 && this->parent->at(0) != -1)) {
+            throw std::invalid_argument("The parents do not form a tree rooted at node 0");
+        }
+
+        // the depth of a node is known once the one of its parent is: follow the parents up to a known depth
+        this->depth.assign(num_nodes, -1);
+        std::vector<int> path {};
+        for (int node = 0; node < num_nodes; node++) {
+            int current { node };
+            while (current != -1 && this->depth.at(current) == -1) {
+                path.push_back(current);
+                current = this->parent->at(current);
+                if (static_cast<int>(path.size()) > num_nodes) {
+                    throw std::invalid_argument("The parents do not form a tree rooted at node 0");
+                }
+            }
+
+            int current_depth { current == -1 ? -1 : this->depth.at(current) };
+            for (auto it = path.rbegin(); it != path.rend(); it++) {
+                this->depth.at(*it) = ++current_depth;
+            }
+            path.clear();
+        }
+    }
+
+    int GomoryHuTree::getNumNodes() const {
+        return static_cast<int>(this->parent->size());
+    }
+
+    std::shared_ptr<std::vector<int>> GomoryHuTree::getParents() const {
+        return this->parent;
+    }
+
+    std::shared_ptr<std::vector<types::accumulator_t>> GomoryHuTree::getWeights() const {
+        return this->weight;
+    }
+
+    types::accumulator_t GomoryHuTree::getMinCut(int u, int v) const {
+        if (u < 0 || u >= this->getNumNodes() || v < 0 || v >= this->getNumNodes()) {
+            throw std::invalid_argument("The node does not exist");
+        }
+        if (u == v) {
+            throw std::invalid_argument("The two nodes of a cut must be different");
+        }
+
+        // climb from the deeper node until the two nodes meet at their lowest common ancestor
+        types::accumulator_t min_cut { std::numeric_limits<types::accumulator_t>::max() };
+        while (u != v) {
+            if (this->depth[u] < this->depth[v]) {
+                std::swap(u, v);
+            }
+            min_cut = std::min(min_cut, (*this->weight)[u]);
+            u = (*this->parent)[u];
+        }
+
+        return min_cut;
+    }
+}
\ No newline at end of file
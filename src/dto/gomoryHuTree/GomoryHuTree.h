@@ -0,0 +1,74 @@
+#ifndef MINIMUM_COST_FLOWS_PROBLEM_GOMORYHUTREE_H
+#define MINIMUM_COST_FLOWS_PROBLEM_GOMORYHUTREE_H
+
+#include "types/Types.h"
+
+#include <vector>
+#include <memory>
+
+namespace dto {
+    /**
+     * Class that represents a Gomory-Hu tree of a graph, where the capacity of an edge {u, v}
+     * is the sum of the capacities of u -> v and v -> u.
+     * The tree is rooted at node 0: each other node has a parent and the weight of the tree edge
+     * to its parent, equal to the minimum cut between the two nodes.
+     * The minimum cut between any two nodes is the minimum weight on the tree path between them.
+     */
+    class GomoryHuTree {
+    public:
+        /**
+         * Gomory-Hu tree constructor.
+         *
+         * @param parent the parent of each node (-1 for the root)
+         * @param weight the weight of the tree edge between each node and its parent
+         *
+         * @throws invalid_argument if the parents do not form a tree rooted at node 0
+         */
+        GomoryHuTree(std::shared_ptr<std::vector<int>> parent, std::shared_ptr<std::vector<types::accumulator_t>> weight);
+
+        /**
+         * Returns the number of nodes.
+         *
+         * @return the number of nodes
+         */
+        [[nodiscard]] int getNumNodes() const;
+
+        /**
+         * Returns the parent of each node.
+         *
+         * @return the parent of each node (-1 for the root)
+         */
+        [[nodiscard]] std::shared_ptr<std::vector<int>> getParents() const;
+
+        /**
+         * Returns the weight of the tree edge between each node and its parent.
+         *
+         * @return the weight of each tree edge, indexed by the child node
+         */
+        [[nodiscard]] std::shared_ptr<std::vector<types::accumulator_t>> getWeights() const;
+
+        /**
+         * Returns the minimum cut between two nodes: the minimum weight on the tree path between them.
+         *
+         * D: depth of the tree
+         * Time complexity: O(D)
+         *
+         * @param u the first node
+         * @param v the second node
+         *
+         * @return the capacity of the minimum cut between u and v
+         *
+         * @throws invalid_argument if a node does not exist or the two nodes are equal
+         */
+        [[nodiscard]] types::accumulator_t getMinCut(int u, int v) const;
+
+    private:
+        std::shared_ptr<std::vector<int>> parent;
+        std::shared_ptr<std::vector<types::accumulator_t>> weight;
+
+        // depth of each node in the tree (0 for the root)
+        std::vector<int> depth;
+    };
+}
+
+#endif //MINIMUM_COST_FLOWS_PROBLEM_GOMORYHUTREE_H
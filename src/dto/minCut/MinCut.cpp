@@ -0,0 +1,23 @@
+#include "MinCut.h"
+
+#include <utility>
+
+namespace dto {
+    MinCut::MinCut(std::shared_ptr<std::vector<bool>> source_side, std::shared_ptr<std::vector<data_structures::Edge>> cut_edges,
+        types::accumulator_t capacity) :
+        source_side(std::move(source_side)),
+        cut_edges(std::move(cut_edges)),
+        capacity(capacity) {}
+
+    std::shared_ptr<std::vector<bool>> MinCut::getSourceSide() const {
+        return this->source_side;
+    }
+
+    std::shared_ptr<std::vector<data_structures::Edge>> MinCut::getCutEdges() const {
+        return this->cut_edges;
+    }
+
+    types::accumulator_t MinCut::getCapacity() const {
+        return this->capacity;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,57 @@
+#ifndef MINIMUM_COST_FLOWS_PROBLEM_MINCUT_H
+#define MINIMUM_COST_FLOWS_PROBLEM_MINCUT_H
+
+#include "types/Types.h"
+#include "data_structures/graph/Edge.h"
+
+#include <vector>
+#include <memory>
+
+namespace dto {
+    /**
+     * Class that represents a minimum s-t cut, obtained from the residual network of a maximum flow.
+     * It contains the source side of the cut (the nodes reachable from the source in the residual network),
+     * the edges going from the source side to the sink side (all saturated) and the capacity of the cut,
+     * equal to the maximum flow.
+     */
+    class MinCut {
+    public:
+        /**
+         * Minimum cut constructor.
+         *
+         * @param source_side true for the nodes on the source side of the cut, false for the others
+         * @param cut_edges   the edges from the source side to the sink side, with their capacity
+         * @param capacity    the capacity of the cut
+         */
+        MinCut(std::shared_ptr<std::vector<bool>> source_side, std::shared_ptr<std::vector<data_structures::Edge>> cut_edges,
+            types::accumulator_t capacity);
+
+        /**
+         * Returns the source side of the cut.
+         *
+         * @return true for the nodes on the source side of the cut, false for the others
+         */
+        [[nodiscard]] std::shared_ptr<std::vector<bool>> getSourceSide() const;
+
+        /**
+         * Returns the edges from the source side to the sink side.
+         *
+         * @return the edges of the cut, with their capacity
+         */
+        [[nodiscard]] std::shared_ptr<std::vector<data_structures::Edge>> getCutEdges() const;
+
+        /**
+         * Returns the capacity of the cut.
+         *
+         * @return the sum of the capacities of the edges of the cut
+         */
+        [[nodiscard]] types::accumulator_t getCapacity() const;
+
+    private:
+        std::shared_ptr<std::vector<bool>> source_side;
+        std::shared_ptr<std::vector<data_structures::Edge>> cut_edges;
+        types::accumulator_t capacity;
+    };
+}
+
+#endif //MINIMUM_COST_FLOWS_PROBLEM_MINCUT_H
@@ -0,0 +1,27 @@
+#include "SolverStats.h"
+
+#include <utility>
+
+namespace dto {
+    SolverStats::SolverStats(std::map<std::string, long long> counters, std::map<std::string, double> phase_times) :
+        counters(std::move(counters)),
+        phase_times(std::move(phase_times)) {}
+
+    SolverStats::SolverStats(std::map<std::string, long long> counters, std::map<std::string, double> phase_times,
+        std::map<std::string, std::map<std::string, long long>> phase_events) :
+        counters(std::move(counters)),
+        phase_times(std::move(phase_times)),
+        phase_events(std::move(phase_events)) {}
+
+    const std::map<std::string, long long>& SolverStats::getCounters() const {
+        return this->counters;
+    }
+
+    const std::map<std::string, double>& SolverStats::getPhaseTimes() const {
+        return this->phase_times;
+    }
+
+    const std::map<std::string, std::map<std::string, long long>>& SolverStats::getPhaseEvents() const {
+        return this->phase_events;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+#ifndef MINIMUM_COST_FLOWS_PROBLEM_SOLVERSTATS_H
+#define MINIMUM_COST_FLOWS_PROBLEM_SOLVERSTATS_H
+
+#include <map>
+#include <string>
+
+namespace dto {
+    /**
+     * Class that represents the statistics of a run of an algorithm (see utils::Stats):
+     * the value of each counter (e.g. "augmentations"), the wall time of each phase in milliseconds
+     * (e.g. "shortest_paths") and the hardware events of each phase (e.g. "llc_misses", see utils::PerfCounters).
+     * The phases can be nested (e.g. "global_relabel" is part of "max_flow", every phase is part of "solve").
+     */
+    class SolverStats {
+    public:
+        /**
+         * Statistics constructor.
+         *
+         * @param counters     the value of each counter
+         * @param phase_times  the wall time of each phase in milliseconds
+         */
+        SolverStats(std::map<std::string, long long> counters, std::map<std::string, double> phase_times);
+
+        /**
+         * Statistics constructor with hardware events.
+         *
+         * @param counters     the value of each counter
+         * @param phase_times  the wall time of each phase in milliseconds
+         * @param phase_events the value of each hardware event of each phase
+         */
+        SolverStats(std::map<std::string, long long> counters, std::map<std::string, double> phase_times,
+            std::map<std::string, std::map<std::string, long long>> phase_events);
+
+        /**
+         * Returns the counters.
+         *
+         * @return the value of each counter
+         */
+        [[nodiscard]] const std::map<std::string, long long>& getCounters() const;
+
+        /**
+         * Returns the phase times.
+         *
+         * @return the wall time of each phase in milliseconds
+         */
+        [[nodiscard]] const std::map<std::string, double>& getPhaseTimes() const;
+
+        /**
+         * Returns the hardware events.
+         *
+         * @return the value of each hardware event of each phase (empty if the events are not read)
+         */
+        [[nodiscard]] const std::map<std::string, std::map<std::string, long long>>& getPhaseEvents() const;
+
+    private:
+        std::map<std::string, long long> counters;
+        std::map<std::string, double> phase_times;
+        std::map<std::string, std::map<std::string, long long>> phase_events;
+    };
+}
+
+#endif //MINIMUM_COST_FLOWS_PROBLEM_SOLVERSTATS_H
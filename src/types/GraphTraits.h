@@ -0,0 +1,26 @@
+#ifndef MINIMUM_COST_FLOWS_PROBLEM_GRAPHTRAITS_H
+#define MINIMUM_COST_FLOWS_PROBLEM_GRAPHTRAITS_H
+
+namespace types {
+    /**
+     * Traits of a graph with arbitrary capacities.
+     * The algorithms are templated on the traits, so that the compiler can generate a dedicated
+     * kernel for each kind of graph (the right one is selected at runtime looking at the input graph).
+     */
+    struct GeneralCapacityTraits {
+        // true if every edge has capacity 1
+        static constexpr bool unit_capacity { false };
+    };
+
+    /**
+     * Traits of a graph where every edge has capacity 1 (e.g. matching problems).
+     * In the residual graph of such a graph every edge has residual capacity 1, so the bottleneck
+     * of an augmenting path is always 1 and sending flow always saturates the edge.
+     */
+    struct UnitCapacityTraits {
+        // true if every edge has capacity 1
+        static constexpr bool unit_capacity { true };
+    };
+}
+
+#endif //MINIMUM_COST_FLOWS_PROBLEM_GRAPHTRAITS_H
@@ -0,0 +1,26 @@
+#ifndef MINIMUM_COST_FLOWS_PROBLEM_TYPES_H
+#define MINIMUM_COST_FLOWS_PROBLEM_TYPES_H
+
+#include <cstdint>
+
+namespace types {
+#ifdef NETWORK_FLOWS_COMPACT_WEIGHTS
+    // capacity of an edge (32-bit, enabled with the NETWORK_FLOWS_COMPACT_WEIGHTS cmake option)
+    using capacity_t = std::int32_t;
+
+    // cost per unit flow of an edge (32-bit, enabled with the NETWORK_FLOWS_COMPACT_WEIGHTS cmake option)
+    using cost_t = std::int32_t;
+#else
+    // capacity of an edge
+    using capacity_t = std::int64_t;
+
+    // cost per unit flow of an edge
+    using cost_t = std::int64_t;
+#endif
+
+    // used to accumulate flows, total costs and path distances.
+    // It is always 64-bit, also when capacities and costs are compact.
+    using accumulator_t = std::int64_t;
+}
+
+#endif //MINIMUM_COST_FLOWS_PROBLEM_TYPES_H
@@ -0,0 +1,112 @@
+#ifndef MINIMUM_COST_FLOWS_PROBLEM_ARITHMETICUTILS_H
+#define MINIMUM_COST_FLOWS_PROBLEM_ARITHMETICUTILS_H
+
+#include <string>
+#include <stdexcept>
+#include <type_traits>
+
+namespace utils {
+    /**
+     * Overflow-checked integer arithmetic.
+     * Capacities, costs and their sums come from the input file, so every operation
+     * that can exceed the range of its type throws instead of silently wrapping around.
+     */
+    class ArithmeticUtils {
+        public:
+            /**
+             * Sum two integers.
+             *
+             * @param a the first addend
+             * @param b the second addend
+             *
+             * @return a + b
+             *
+             * @throws overflow_error if the result does not fit in T
+             */
+            template <typename T>
+            static T CheckedAdd(T a, T b) {
+                static_assert(std::is_integral_v<T>, "CheckedAdd requires an integral type");
+                T result {};
+                if (__builtin_add_overflow(a, b, &result)) {
+                    throw std::overflow_error("integer overflow in addition");
+                }
+                return result;
+            }
+
+            /**
+             * Sum two integers without throwing.
+             *
+             * @param a      the first addend
+             * @param b      the second addend
+             * @param result output: a + b, if it fits in T
+             *
+             * @return true if a + b fits in T, false otherwise
+             */
+            template <typename T>
+            static bool TryAdd(T a, T b, T& result) {
+                static_assert(std::is_integral_v<T>, "TryAdd requires an integral type");
+                return !__builtin_add_overflow(a, b, &result);
+            }
+
+            /**
+             * Subtract two integers.
+             *
+             * @param a the minuend
+             * @param b the subtrahend
+             *
+             * @return a - b
+             *
+             * @throws overflow_error if the result does not fit in T
+             */
+            template <typename T>
+            static T CheckedSub(T a, T b) {
+                static_assert(std::is_integral_v<T>, "CheckedSub requires an integral type");
+                T result {};
+                if (__builtin_sub_overflow(a, b, &result)) {
+                    throw std::overflow_error("integer overflow in subtraction");
+                }
+                return result;
+            }
+
+            /**
+             * Multiply two integers.
+             *
+             * @param a the first factor
+             * @param b the second factor
+             *
+             * @return a * b
+             *
+             * @throws overflow_error if the result does not fit in T
+             */
+            template <typename T>
+            static T CheckedMul(T a, T b) {
+                static_assert(std::is_integral_v<T>, "CheckedMul requires an integral type");
+                T result {};
+                if (__builtin_mul_overflow(a, b, &result)) {
+                    throw std::overflow_error("integer overflow in multiplication");
+                }
+                return result;
+            }
+
+            /**
+             * Convert an integer to another integer type.
+             *
+             * @param value the value to convert
+             *
+             * @return the value converted to To
+             *
+             * @throws overflow_error if the value does not fit in To
+             */
+            template <typename To, typename From>
+            static To CheckedCast(From value) {
+                static_assert(std::is_integral_v<To> && std::is_integral_v<From>, "CheckedCast requires integral types");
+                To result {};
+                if (__builtin_add_overflow(value, 0, &result)) {
+                    throw std::overflow_error("integer value " + std::to_string(value) + " out of range");
+                }
+                return result;
+            }
+    };
+}
+
+#endif //MINIMUM_COST_FLOWS_PROBLEM_ARITHMETICUTILS_H
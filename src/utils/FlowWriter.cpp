@@ -0,0 +1,267 @@
+#include "FlowWriter.h"
+
+#include "GraphUtils.h"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <charconv>
+#include <stdexcept>
+#include <string_view>
+
+namespace utils {
+    namespace {
+        /**
+         * Fixed size buffer flushed to the output stream when full.
+         */
+        class OutputBuffer {
+            public:
+                explicit OutputBuffer(std::ostream& out) : out(out), size(0) {}
+
+                ~OutputBuffer() { this->flush(); }
+
+                void append(std::string_view text) {
+                    if (this->size + text.size() > this->buffer.size()) {
+                        this->flush();
+                    }
+                    // the text is never longer than the buffer
+                    std::memcpy(this->buffer.data() + this->size, text.data(), text.size());
+                    this->size += text.size();
+                }
+
+                void appendInteger(std::int64_t value) {
+                    if (this->size + max_integer_length > this->buffer.size()) {
+                        this->flush();
+                    }
+                    auto result = std::to_chars(this->buffer.data() + this->size, this->buffer.data() + this->buffer.size(), value);
+                    this->size = static_cast<std::size_t>(result.ptr - this->buffer.data());
+                }
+
+                template <typename T>
+                void appendBytes(T value) {
+                    if (this->size + sizeof(T) > this->buffer.size()) {
+                        this->flush();
+                    }
+                    std::memcpy(this->buffer.data() + this->size, &value, sizeof(T));
+                    this->size += sizeof(T);
+                }
+
+                void flush() {
+                    this->out.write(this->buffer.data(), static_cast<std::streamsize>(this->size));
+                    this->size = 0;
+                }
+
+            private:
+                // sign and digits of the longest int64
+                static constexpr std::size_t max_integer_length { 20 };
+
+                std::ostream& out;
+                std::array<char, 1 << 16> buffer {};
+                std::size_t size;
+        };
+    }
+
+    FlowWriter::Format FlowWriter::ParseFormat(const std::string& name) {
+        if (name == "json") {
+            return Format::PrettyJson;
+        }
+        if (name == "compact-json") {
+            return Format::CompactJson;
+        }
+        if (name == "csv") {
+            return Format::Csv;
+        }
+        if (name == "binary") {
+            return Format::Binary;
+        }
+        throw std::invalid_argument("Unknown output format " + name + " (json, compact-json, csv or binary)");
+    }
+
+    void FlowWriter::Write(std::ostream& out, const std::shared_ptr<data_structures::Graph>& graph,
+        const std::vector<types::capacity_t>& edge_flows, Format format) {
+
+        std::size_t num_edges {};
+        for (int node = 0; node < graph->getNumNodes(); node++) {
+            num_edges += graph->getNodeAdjList(node)->size();
+        }
+        if (num_edges != edge_flows.size()) {
+            throw std::invalid_argument("The number of flows is not equal to the number of edges");
+        }
+
+        FlowWriter::writeEdges(out, graph, &edge_flows, false, format);
+    }
+
+    void FlowWriter::WriteGraph(std::ostream& out, const std::shared_ptr<data_structures::Graph>& graph, Format format) {
+        FlowWriter::writeEdges(out, graph, nullptr, true, format);
+    }
+
+    void FlowWriter::writeEdges(std::ostream& out, const std::shared_ptr<data_structures::Graph>& graph,
+        const std::vector<types::capacity_t>* values, bool all_edges, Format format) {
+
+        std::int64_t num_written {};
+        if (all_edges) {
+            for (int node = 0; node < graph->getNumNodes(); node++) {
+                num_written += static_cast<std::int64_t>(graph->getNodeAdjList(node)->size());
+            }
+        } else {
+            std::size_t edge {};
+            for (int node = 0; node < graph->getNumNodes(); node++) {
+                for (const auto& e : *graph->getNodeAdjList(node)) {
+                    num_written += (values ? (*values)[edge++] : e.getCapacity()) > 0;
+                }
+            }
+        }
+
+        // the separators of the two JSON formats
+        bool pretty { format == Format::PrettyJson };
+        std::string_view first_edge { pretty ? "\n        {\n            \"Source\": " : "{\"Source\":" };
+        std::string_view next_edge { pretty ? ",\n        {\n            \"Source\": " : ",{\"Source\":" };
+        std::string_view sink { pretty ? ",\n            \"Sink\": " : ",\"Sink\":" };
+        std::string_view capacity { pretty ? ",\n            \"Capacity\": " : ",\"Capacity\":" };
+        std::string_view cost { pretty ? ",\n            \"Cost\": " : ",\"Cost\":" };
+        std::string_view edge_end { pretty ? "\n        }" : "}" };
+
+        OutputBuffer buffer(out);
+        switch (format) {
+            case Format::PrettyJson:
+            case Format::CompactJson:
+                buffer.append(pretty ? "{\n    \"Edges\": [" : "{\"Edges\":[");
+                break;
+            case Format::Csv:
+                buffer.append(values ? "Source,Sink,Flow,Cost\n" : "Source,Sink,Capacity,Cost\n");
+                break;
+            case Format::Binary:
+                buffer.append("NFLW");
+                buffer.appendBytes<std::int64_t>(num_written);
+                break;
+        }
+
+        std::size_t edge {};
+        bool first { true };
+        for (int node = 0; node < graph->getNumNodes(); node++) {
+            for (const auto& e : *graph->getNodeAdjList(node)) {
+                types::capacity_t flow { values ? (*values)[edge++] : e.getCapacity() };
+                if (!all_edges && flow <= 0) {
+                    continue;
+                }
+
+                switch (format) {
+                    case Format::PrettyJson:
+                    case Format::CompactJson:
+                        buffer.append(first ? first_edge : next_edge);
+                        buffer.appendInteger(e.getSource());
+                        buffer.append(sink);
+                        buffer.appendInteger(e.getSink());
+                        buffer.append(capacity);
+                        buffer.appendInteger(flow);
+                        buffer.append(cost);
+                        buffer.appendInteger(e.getCost());
+                        buffer.append(edge_end);
+                        break;
+                    case Format::Csv:
+                        buffer.appendInteger(e.getSource());
+                        buffer.append(",");
+                        buffer.appendInteger(e.getSink());
+                        buffer.append(",");
+                        buffer.appendInteger(flow);
+                        buffer.append(",");
+                        buffer.appendInteger(e.getCost());
+                        buffer.append("\n");
+                        break;
+                    case Format::Binary:
+                        buffer.appendBytes<std::int32_t>(e.getSource());
+                        buffer.appendBytes<std::int32_t>(e.getSink());
+                        buffer.appendBytes<std::int64_t>(flow);
+                        buffer.appendBytes<std::int64_t>(e.getCost());
+                        break;
+                }
+                first = false;
+            }
+        }
+
+        if (format == Format::PrettyJson) {
+            buffer.append(first ? "]\n}" : "\n    ]\n}");
+        } else if (format == Format::CompactJson) {
+            buffer.append("]}");
+        }
+    }
+
+    void FlowWriter::WritePaths(std::ostream& out, const std::shared_ptr<data_structures::Graph>& graph,
+        const std::vector<types::capacity_t>& edge_flows, int source, int sink, Format format) {
+
+        // the separators of the two JSON formats
+        bool pretty { format == Format::PrettyJson };
+        std::string_view first_path { pretty ? "\n        {\n            \"Kind\": " : "{\"Kind\":" };
+        std::string_view next_path { pretty ? ",\n        {\n            \"Kind\": " : ",{\"Kind\":" };
+        std::string_view flow_field { pretty ? ",\n            \"Flow\": " : ",\"Flow\":" };
+        std::string_view nodes_field { pretty ? ",\n            \"Nodes\": [" : ",\"Nodes\":[" };
+        std::string_view node_separator { pretty ? ", " : "," };
+        std::string_view path_end { pretty ? "]\n        }" : "]}" };
+
+        OutputBuffer buffer(out);
+        switch (format) {
+            case Format::PrettyJson:
+            case Format::CompactJson:
+                buffer.append(pretty ? "{\n    \"Paths\": [" : "{\"Paths\":[");
+                break;
+            case Format::Csv:
+                buffer.append("Kind,Flow,Nodes\n");
+                break;
+            case Format::Binary:
+                buffer.append("NPTH");
+                break;
+        }
+
+        bool first { true };
+        GraphUtils::DecomposeFlow(graph, edge_flows, source, sink, [&](const std::vector<int>& nodes, types::capacity_t flow, bool cycle) {
+            switch (format) {
+                case Format::PrettyJson:
+                case Format::CompactJson:
+                    buffer.append(first ? first_path : next_path);
+                    buffer.append(cycle ? "\"cycle\"" : "\"path\"");
+                    buffer.append(flow_field);
+                    buffer.appendInteger(flow);
+                    buffer.append(nodes_field);
+                    for (std::size_t i = 0; i < nodes.size(); i++) {
+                        if (i > 0) {
+                            buffer.append(node_separator);
+                        }
+                        buffer.appendInteger(nodes[i]);
+                    }
+                    buffer.append(path_end);
+                    break;
+                case Format::Csv:
+                    buffer.append(cycle ? "cycle," : "path,");
+                    buffer.appendInteger(flow);
+                    buffer.append(",");
+                    for (std::size_t i = 0; i < nodes.size(); i++) {
+                        if (i > 0) {
+                            buffer.append(" ");
+                        }
+                        buffer.appendInteger(nodes[i]);
+                    }
+                    buffer.append("\n");
+                    break;
+                case Format::Binary:
+                    buffer.appendBytes<std::int32_t>(cycle ? 1 : 0);
+                    buffer.appendBytes<std::int32_t>(static_cast<std::int32_t>(nodes.size()));
+                    buffer.appendBytes<std::int64_t>(flow);
+                    for (int node : nodes) {
+                        buffer.appendBytes<std::int32_t>(node);
+                    }
+                    break;
+            }
+            first = false;
+        });
+
+        if (format == Format::PrettyJson) {
+            buffer.append(first ? "]\n}" : "\n    ]\n}");
+        } else if (format == Format::CompactJson) {
+            buffer.append("]}");
+        } else if (format == Format::Binary) {
+            buffer.appendBytes<std::int32_t>(0);
+            buffer.appendBytes<std::int32_t>(0);
+            buffer.appendBytes<std::int64_t>(0);
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,117 @@
+#ifndef MINIMUM_COST_FLOWS_PROBLEM_FLOWWRITER_H
+#define MINIMUM_COST_FLOWS_PROBLEM_FLOWWRITER_H
+
+#include "types/Types.h"
+#include "data_structures/graph/Graph.h"
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <ostream>
+
+namespace utils {
+    /**
+     * Writer of the solutions of the flow algorithms.
+     * The flows are read from a flat array indexed as the edges of the graph (see GraphUtils::GetEdgeFlows())
+     * and formatted into a fixed size buffer that is flushed to the output stream when full,
+     * so no intermediate string or graph is built, whatever the size of the solution.
+     * Only the edges with positive flow are written, with the flow in place of the capacity
+     * (a whole graph is written in the same formats with every edge and its capacity, the CSV header
+     * has Capacity in place of Flow, see WriteGraph()):
+     *  - pretty JSON: {"Edges": [{"Source": u, "Sink": v, "Capacity": flow, "Cost": cost}, ...]} indented by 4 spaces
+     *  - compact JSON: the same object without whitespace
+     *  - CSV: a "Source,Sink,Flow,Cost" header and one line per edge
+     *  - binary: the magic "NFLW", the number of edges (int64), then for each edge source and sink (int32),
+     *    flow and cost (int64), in the byte order of the machine
+     * The decomposition of a flow into paths and cycles (see GraphUtils::DecomposeFlow()) is written while it is
+     * computed, in the same formats, with the nodes of each path (a cycle ends with its first node):
+     *  - pretty JSON: {"Paths": [{"Kind": "path" or "cycle", "Flow": flow, "Nodes": [u, v, ...]}, ...]} indented by 4 spaces
+     *  - compact JSON: the same object without whitespace
+     *  - CSV: a "Kind,Flow,Nodes" header and one line per path, with the nodes separated by spaces
+     *  - binary: the magic "NPTH", then for each path the kind (int32, 0 for a path and 1 for a cycle),
+     *    the number of nodes (int32), the flow (int64) and the nodes (int32), ended by a path without nodes
+     */
+    class FlowWriter {
+        public:
+            /**
+             * Output formats.
+             */
+            enum class Format { PrettyJson, CompactJson, Csv, Binary };
+
+            /**
+             * Get the format from its name: "json", "compact-json", "csv" or "binary".
+             *
+             * @param name the name of the format
+             *
+             * @return the format
+             *
+             * @throws invalid_argument if the name is not a format
+             */
+            static Format ParseFormat(const std::string& name);
+
+            /**
+             * Write the edges with positive flow.
+             *
+             * E: number of edges
+             * Time complexity: O(E)
+             *
+             * @param out        the output stream (opened in binary mode for the binary format)
+             * @param graph      the graph
+             * @param edge_flows the flow of each edge of the graph
+             * @param format     the output format
+             *
+             * @throws invalid_argument if the number of flows is not equal to the number of edges
+             */
+            static void Write(std::ostream& out, const std::shared_ptr<data_structures::Graph>& graph,
+                const std::vector<types::capacity_t>& edge_flows, Format format);
+
+            /**
+             * Write every edge of the graph with its capacity, the edges with capacity 0 included.
+             *
+             * E: number of edges
+             * Time complexity: O(E)
+             *
+             * @param out    the output stream (opened in binary mode for the binary format)
+             * @param graph  the graph
+             * @param format the output format
+             */
+            static void WriteGraph(std::ostream& out, const std::shared_ptr<data_structures::Graph>& graph, Format format);
+
+            /**
+             * Write the decomposition of the flow into source-sink paths and cycles (see GraphUtils::DecomposeFlow()).
+             *
+             * V: number of nodes
+             * E: number of edges
+             * P: number of paths and cycles
+             * Time complexity: O(V + E * P)
+             *
+             * @param out        the output stream (opened in binary mode for the binary format)
+             * @param graph      the graph
+             * @param edge_flows the flow of each edge of the graph
+             * @param source     the source node
+             * @param sink       the sink node
+             * @param format     the output format
+             *
+             * @throws invalid_argument if the number of flows is not equal to the number of edges
+             * @throws invalid_argument if the flow is not conserved at some node (except the source and the sink)
+             * @throws invalid_argument if the net flow leaving the source is negative
+             */
+            static void WritePaths(std::ostream& out, const std::shared_ptr<data_structures::Graph>& graph,
+                const std::vector<types::capacity_t>& edge_flows, int source, int sink, Format format);
+
+        private:
+            /**
+             * Write the edges of the graph with a value in place of the capacity.
+             *
+             * @param out       the output stream (opened in binary mode for the binary format)
+             * @param graph     the graph
+             * @param values    the value of each edge of the graph, nullptr to write the capacities
+             * @param all_edges true to write every edge, false to write only the edges with positive value
+             * @param format    the output format
+             */
+            static void writeEdges(std::ostream& out, const std::shared_ptr<data_structures::Graph>& graph,
+                const std::vector<types::capacity_t>* values, bool all_edges, Format format);
+    };
+}
+
+#endif //MINIMUM_COST_FLOWS_PROBLEM_FLOWWRITER_H
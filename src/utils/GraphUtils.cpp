@@ -2,9 +2,11 @@
 
 #include "json.hpp"
 #include "consts/Consts.h"
+#include "ArithmeticUtils.h"
 #include "data_structures/graph/Edge.h"
 
 #include <string>
+#include <limits>
 #include <memory>
 #include <fstream>
 #include <stdexcept>
@@ -37,8 +39,10 @@ namespace utils {
                 for (auto& e : edges) {
                     int source { e.at("Source") };
                     int sink { e.at("Sink") };
-                    int capacity { e.at("Capacity") };
-                    int cost { e.at("Cost") };
+                    // values are read as 64-bit and then narrowed, so that a value too big for the
+                    // capacity or cost type is reported instead of being truncated
+                    auto capacity { ArithmeticUtils::CheckedCast<types::capacity_t>(e.at("Capacity").get<std::int64_t>()) };
+                    auto cost { ArithmeticUtils::CheckedCast<types::cost_t>(e.at("Cost").get<std::int64_t>()) };
 
                     // add edge to graph
                     graph->addEdge(source, sink, capacity, cost);
@@ -54,94 +58,185 @@ namespace utils {
         }
     }
 
-    std::shared_ptr<data_structures::Graph> GraphUtils::GetResidualGraph(const std::shared_ptr<data_structures::Graph>& graph) {
-        auto residual_graph = std::make_shared<data_structures::Graph>(graph->getNumNodes());
+    std::shared_ptr<data_structures::Graph> GraphUtils::GetOptimalGraph(const std::shared_ptr<data_structures::Graph>& graph,
+        const std::vector<types::capacity_t>& edge_flows) {
 
+        auto optimal_graph = std::make_shared<data_structures::Graph>(graph->getNumNodes());
+        std::size_t edge {};
         for (int source = 0; source < graph->getNumNodes(); source++) {
-            for (auto e : *graph->getNodeAdjList(source)) {
-                int sink { e.getSink() };
-                int capacity { e.getCapacity() };
-                int cost { e.getCost() };
+            for (const auto& e : *graph->getNodeAdjList(source)) {
+                optimal_graph->addEdge(source, e.getSink(), edge_flows[edge++], e.getCost());
+            }
+        }
 
-                // the residual graph contains only the edges with positive capacity
-                if (capacity <= 0) {
-                    continue;
-                }
+        return optimal_graph;
+    }
 
-                // handle anti-parallel edges adding an artificial node between source and sink.
-                // the value of the artificial node is the value of source node plus the number of nodes,
-                // it will be easy to retrieve the original source node from the artificial node doing a simple subtraction
-
-                // check if the edge is anti-parallel, and it is not already in the residual graph (source < sink)
-                if (source < sink && graph->hasEdge(sink, source)) {
-                    // add the artificial node
-                    int artificial_node { residual_graph->getNumNodes() };
-                    residual_graph->addEdge(source, artificial_node, capacity, cost);
-                    residual_graph->addEdge(artificial_node, sink, capacity, cost);
-                    residual_graph->addArtificialNodes(artificial_node, e);
-                } else {
-                    // else simply add the edge to the residual graph
-                    residual_graph->addEdge(source, sink, capacity, cost);
-                }
-            }
+    std::shared_ptr<data_structures::Graph> GraphUtils::GetOptimalGraph(const std::shared_ptr<data_structures::GraphSnapshot>& snapshot,
+        const std::vector<types::capacity_t>& edge_flows) {
+
+        auto optimal_graph = std::make_shared<data_structures::Graph>(snapshot->getNumNodes());
+        for (int edge = 0; edge < snapshot->getNumEdges(); edge++) {
+            optimal_graph->addEdge(snapshot->getEdgeSource(edge), snapshot->getEdgeSink(edge), edge_flows[edge], snapshot->getEdgeCost(edge));
         }
 
-        return residual_graph;
+        return optimal_graph;
     }
 
-    std::shared_ptr<data_structures::Graph> GraphUtils::GetOptimalGraph(const std::shared_ptr<data_structures::Graph>& residual_graph,
+    std::shared_ptr<std::vector<types::capacity_t>> GraphUtils::GetEdgeFlows(const std::shared_ptr<data_structures::ResidualNetwork>& network,
         const std::shared_ptr<data_structures::Graph>& graph) {
 
-        auto optimal_graph = std::make_shared<data_structures::Graph>(residual_graph->getStartingNumNodes());
-        auto artificial_nodes = residual_graph->getArtificialNodesMap();
-
+        auto edge_flows = std::make_shared<std::vector<types::capacity_t>>();
         for (int source = 0; source < graph->getNumNodes(); source++) {
-            for (auto e : *residual_graph->getNodeAdjList(source)) {
-                
-                int sink { e.getSink() };
-                
-                // discard the edges present in the original graph
-                // since they contain the remaining capacity of the edge.
-                if (graph->hasEdge(source, sink)) {
-                    continue;
+            // the i-th forward arc leaving the node is its i-th edge
+            for (int arc = network->getFirstArc(source); arc < network->getLastArc(source); arc++) {
+                if (network->isForward(arc)) {
+                    edge_flows->push_back(network->getResidualCapacity(network->getTwin(arc)));
                 }
+            }
+        }
 
-                int capacity { e.getCapacity() };
+        return edge_flows;
+    }
 
-                // remove the artificial node added to handle anti-parallel edges
-                if (sink >= graph->getNumNodes()) {
-                    // get the original source node by getting the sink of
-                    // the only edge of the artificial node not the opposite of the current edge
-                    auto original_edge = artificial_nodes->find(sink)->second;
+    std::shared_ptr<std::vector<types::capacity_t>> GraphUtils::GetEdgeFlows(const std::shared_ptr<data_structures::ResidualNetwork>& network,
+        const std::shared_ptr<data_structures::GraphSnapshot>& snapshot) {
 
-                    // since we are looking for the backward edge,
-                    // if the source is the original one, continue
-                    if (original_edge.getSource() == source) {
-                        continue;
-                    }
+        // the flow of an edge is the residual capacity of the twin of its forward arc
+        auto edge_flows = std::make_shared<std::vector<types::capacity_t>>(snapshot->getNumEdges());
+        for (int edge = 0; edge < snapshot->getNumEdges(); edge++) {
+            (*edge_flows)[edge] = network->getResidualCapacity(network->getTwin(snapshot->getEdgeArc(edge)));
+        }
 
-                    original_edge.setCapacity(capacity);
-                    optimal_graph->addEdge(original_edge);
-                } else {
-                    int start_cost { graph->getEdge(sink, source).getCost() };
+        return edge_flows;
+    }
 
-                    // add the edge to the optimal graph
-                    optimal_graph->addEdge(sink, source, capacity, start_cost);
+    void GraphUtils::DecomposeFlow(const std::shared_ptr<data_structures::Graph>& graph, const std::vector<types::capacity_t>& edge_flows,
+        int source, int sink, const FlowPathCallback& callback) {
+
+        // the edges leaving each node, with the flow left on them
+        int num_nodes { graph->getNumNodes() };
+        std::vector<std::size_t> first_edge(num_nodes + 1, 0);
+        std::vector<int> heads {};
+        heads.reserve(edge_flows.size());
+        for (int node = 0; node < num_nodes; node++) {
+            for (const auto& e : *graph->getNodeAdjList(node)) {
+                heads.push_back(e.getSink());
+            }
+            first_edge[node + 1] = heads.size();
+        }
+        if (heads.size() != edge_flows.size()) {
+            throw std::invalid_argument("The number of flows is not equal to the number of edges");
+        }
+        std::vector<types::capacity_t> flow_left(edge_flows.begin(), edge_flows.end());
+
+        // the net flow leaving the source: the paths carry exactly this flow, the rest of the flow of the source
+        // (e.g. a cycle through the source and the sink) is left to the cycles
+        types::accumulator_t source_flow {};
+        for (int node = 0; node < num_nodes; node++) {
+            for (std::size_t edge = first_edge[node]; edge < first_edge[node + 1]; edge++) {
+                if (node == source) {
+                    source_flow = ArithmeticUtils::CheckedAdd<types::accumulator_t>(source_flow, edge_flows[edge]);
+                }
+                if (heads[edge] == source) {
+                    source_flow = ArithmeticUtils::CheckedSub<types::accumulator_t>(source_flow, edge_flows[edge]);
                 }
             }
         }
+        if (source_flow < 0) {
+            throw std::invalid_argument("The flow enters the source node " + std::to_string(source));
+        }
 
-        // add the edges of the original graph that are not in the residual graph
-        for (int source = 0; source < graph->getNumNodes(); source++) {
-            for (auto e : *graph->getNodeAdjList(source)) {
-                // if the optimal graph does not contain the edge, add it with 0 flow
-                if ( !optimal_graph->hasEdge(source, e.getSink()) ) {
-                    optimal_graph->addEdge(source, e.getSink(), 0, e.getCost());
+        // the next edge of each node that can have flow left
+        std::vector<std::size_t> current_edge(first_edge.begin(), first_edge.end() - 1);
+
+        // the walk (its nodes and the edges between them) and the position of each node on it (-1 if not on it)
+        std::vector<int> nodes {};
+        std::vector<std::size_t> edges {};
+        std::vector<int> position(num_nodes, -1);
+        std::vector<int> cycle_nodes {};
+
+        // remove the minimum flow of the edges of the walk from an index (for a path at most the net flow left
+        // out of the source), then cut the walk before the first edge left without flow (or at the index for a cycle)
+        auto remove_flow = [&](std::size_t begin, bool cycle) {
+            types::capacity_t flow { flow_left[edges[begin]] };
+            for (std::size_t i = begin; i < edges.size(); i++) {
+                flow = std::min(flow, flow_left[edges[i]]);
+            }
+            if (!cycle) {
+                flow = static_cast<types::capacity_t>(std::min<types::accumulator_t>(flow, source_flow));
+                source_flow -= flow;
+            }
+
+            std::size_t cut { edges.size() };
+            for (std::size_t i = begin; i < edges.size(); i++) {
+                flow_left[edges[i]] -= flow;
+                if (flow_left[edges[i]] == 0 && cut == edges.size()) {
+                    cut = i;
                 }
             }
-        }
 
-        return optimal_graph;
+            if (cycle) {
+                cycle_nodes.assign(nodes.begin() + static_cast<std::ptrdiff_t>(begin), nodes.end());
+                cycle_nodes.push_back(nodes[begin]);
+                callback(cycle_nodes, flow, true);
+                cut = begin;
+            } else {
+                callback(nodes, flow, false);
+            }
+
+            for (std::size_t i = cut + 1; i < nodes.size(); i++) {
+                position[nodes[i]] = -1;
+            }
+            nodes.resize(cut + 1);
+            edges.resize(cut);
+        };
+
+        // walk from a node until it has no flow left, stopping at the sink if the walk is for paths
+        // (until the source has no net flow left)
+        auto walk = [&](int start, bool paths) {
+            nodes.assign(1, start);
+            edges.clear();
+            position[start] = 0;
+
+            while (!paths || source_flow > 0) {
+                int node { nodes.back() };
+                if (paths && node == sink) {
+                    remove_flow(0, false);
+                    continue;
+                }
+
+                std::size_t& edge = current_edge[node];
+                while (edge < first_edge[node + 1] && flow_left[edge] == 0) {
+                    edge++;
+                }
+                if (edge == first_edge[node + 1]) {
+                    // the flow is conserved: only the start of the walk can be left without flow
+                    if (nodes.size() > 1) {
+                        throw std::invalid_argument("The flow is not conserved at node " + std::to_string(node));
+                    }
+                    break;
+                }
+
+                int head { heads[edge] };
+                edges.push_back(edge);
+                if (position[head] != -1) {
+                    remove_flow(static_cast<std::size_t>(position[head]), true);
+                } else {
+                    position[head] = static_cast<int>(nodes.size());
+                    nodes.push_back(head);
+                }
+            }
+            for (int node : nodes) {
+                position[node] = -1;
+            }
+        };
+
+        // the paths from the source, then the cycles of the circulation left
+        walk(source, true);
+        for (int node = 0; node < num_nodes; node++) {
+            walk(node, false);
+        }
     }
 
     std::shared_ptr<std::vector<int>> GraphUtils::RetrievePath(const std::shared_ptr<std::vector<int>>& parent, int source, int sink) {
@@ -165,8 +260,8 @@ namespace utils {
         return path;
     }
 
-    int GraphUtils::GetResidualCapacity(const std::shared_ptr<data_structures::Graph>& residual_graph, const std::shared_ptr<std::vector<int>>& path) {
-        int path_flow { std::numeric_limits<int>::max() }; 
+    types::capacity_t GraphUtils::GetResidualCapacity(const std::shared_ptr<data_structures::Graph>& residual_graph, const std::shared_ptr<std::vector<int>>& path) {
+        types::capacity_t path_flow { std::numeric_limits<types::capacity_t>::max() };
 
         // if the path is empty or has only one node, return 0
         if (path->size() <= 1) {
@@ -184,16 +279,16 @@ namespace utils {
         return path_flow;
     }
 
-    void GraphUtils::SendFlowInPathNegativeCosts(const std::shared_ptr<data_structures::Graph>& residual_graph, const std::shared_ptr<std::vector<int>>& path, int flow) {
+    void GraphUtils::SendFlowInPathNegativeCosts(const std::shared_ptr<data_structures::Graph>& residual_graph, const std::shared_ptr<std::vector<int>>& path, types::capacity_t flow) {
         for (unsigned u = 0; u < path->size()-1; u++) {
             int v { static_cast<int>(u + 1) };
             int source { path->at(u) };
             int sink { path->at(v) };
 
             auto edge = residual_graph->getEdge(source, sink);
-            int cost { edge.getCost() };
+            types::cost_t cost { edge.getCost() };
             
-            int capacity = { residual_graph->getEdge(source, sink).getCapacity() };
+            types::capacity_t capacity = { residual_graph->getEdge(source, sink).getCapacity() };
             if (capacity < flow) {
                 throw std::invalid_argument("The flow is greater than the residual capacity of the edge");
             }
@@ -209,64 +304,120 @@ namespace utils {
             if (flow) {
                 // if the reverse edge does not exist, add it
                 if (!residual_graph->hasEdge(sink, source)) {
-                    residual_graph->addEdge(sink, source, flow, -cost);
+                    residual_graph->addEdge(sink, source, flow, ArithmeticUtils::CheckedSub<types::cost_t>(0, cost));
                 } else {
-                    residual_graph->setEdgeCapacity(sink, source, residual_graph->getEdge(sink, source).getCapacity() + flow);
+                    residual_graph->setEdgeCapacity(sink, source, ArithmeticUtils::CheckedAdd(residual_graph->getEdge(sink, source).getCapacity(), flow));
                 }
             } 
         }
     }
 
-    void GraphUtils::SendFlowInPathReducedCosts(const std::shared_ptr<data_structures::Graph>& residual_graph, const std::shared_ptr<std::vector<int>>& path, int flow) {
-            for (unsigned u = 0; u < path->size()-1; u++) {
-                int v { static_cast<int>(u + 1) };
-                int source { path->at(u) };
-                int sink { path->at(v) };
-                
-                // send flow in the path, subtract from the residual capacity
-                int capacity { residual_graph->getEdge(source, sink).getCapacity() };
-                if (capacity < flow) {
-                    throw std::invalid_argument("The flow is greater than the residual capacity of the edge");
-                }
-                capacity -= flow;
-                
-                // if residual capacity is 0, remove the edge
-                if (!capacity) {
-                    residual_graph->removeEdge(source, sink);
-                } else {
-                    residual_graph->setEdgeCapacity(source, sink, capacity);
-                }
+    std::shared_ptr<std::vector<int>> GraphUtils::RetrieveArcPath(const std::shared_ptr<data_structures::ResidualNetwork>& network,
+        const std::shared_ptr<std::vector<int>>& parent_arc, int source, int sink) {
 
-                // if there is a flow, add the reverse edge
-                if (flow) {
-                    // if the reverse edge does not exist, add it
-                    if (!residual_graph->hasEdge(sink, source)) {
-                        residual_graph->addEdge(sink, source, flow, 0);
-                    } else {
-                        residual_graph->setEdgeCapacity(sink, source, residual_graph->getEdge(sink, source).getCapacity() + flow);
-                    }
-                }
+        auto arc_path = std::make_shared<std::vector<int>>();
+
+        // walk back from the sink following the parent arcs
+        int node { sink };
+        while (node != source) {
+            int arc { parent_arc->at(node) };
+            if (arc < 0) {
+                throw std::invalid_argument("no path from " + std::to_string(source) + " to " + std::to_string(sink));
             }
+            arc_path->push_back(arc);
+            node = network->getTail(arc);
+        }
+
+        reverse(arc_path->begin(), arc_path->end());
+        return arc_path;
+    }
+
+    std::shared_ptr<std::vector<int>> GraphUtils::RetrieveArcPath(const std::shared_ptr<data_structures::ResidualNetwork>& network,
+        const std::shared_ptr<data_structures::BfsWorkspace>& workspace, int source, int sink) {
+
+        int meeting_node { workspace->getMeetingNode() };
+        if (meeting_node < 0) {
+            throw std::invalid_argument("no path from " + std::to_string(source) + " to " + std::to_string(sink));
+        }
+
+        auto arc_path = std::make_shared<std::vector<int>>();
+
+        // walk back from the meeting node to the source following the forward parent arcs
+        for (int node = meeting_node; node != source; node = network->getTail(arc_path->back())) {
+            arc_path->push_back(workspace->getForwardParentArc(node));
+        }
+        reverse(arc_path->begin(), arc_path->end());
+
+        // walk from the meeting node to the sink following the backward parent arcs
+        for (int node = meeting_node; node != sink; node = network->getHead(arc_path->back())) {
+            arc_path->push_back(workspace->getBackwardParentArc(node));
+        }
+
+        return arc_path;
+    }
+
+    std::shared_ptr<std::vector<int>> GraphUtils::RetrieveArcPath(const std::shared_ptr<data_structures::ResidualNetwork>& network,
+        const std::shared_ptr<data_structures::DijkstraWorkspace>& workspace, int source, int sink) {
+
+        if (!workspace->isReached(sink)) {
+            throw std::invalid_argument("no path from " + std::to_string(source) + " to " + std::to_string(sink));
+        }
+
+        auto arc_path = std::make_shared<std::vector<int>>();
+
+        // walk back from the sink following the parent arcs
+        for (int node = sink; node != source; node = network->getTail(arc_path->back())) {
+            arc_path->push_back(workspace->getParentArc(node));
+        }
+
+        reverse(arc_path->begin(), arc_path->end());
+        return arc_path;
+    }
+
+    types::capacity_t GraphUtils::GetResidualCapacity(const std::shared_ptr<data_structures::ResidualNetwork>& network,
+        const std::shared_ptr<std::vector<int>>& arc_path) {
+
+        if (arc_path->empty()) {
+            return 0;
+        }
+
+        types::capacity_t path_flow { std::numeric_limits<types::capacity_t>::max() };
+        for (int arc : *arc_path) {
+            path_flow = std::min(path_flow, network->getResidualCapacity(arc));
+        }
+
+        return path_flow;
     }
 
-    std::shared_ptr<data_structures::Graph> GraphUtils::GetAdmissibleGraph(const std::shared_ptr<data_structures::Graph>& graph) {
-       auto admissible_graph = std::make_shared<data_structures::Graph>(graph->getNumNodes());
+    void GraphUtils::SendFlowInArcPath(const std::shared_ptr<data_structures::ResidualNetwork>& network,
+        const std::shared_ptr<std::vector<int>>& arc_path, types::capacity_t flow) {
 
+        for (int arc : *arc_path) {
+            network->pushFlow(arc, flow);
+        }
+    }
+
+    bool GraphUtils::HasUnitCapacities(const std::shared_ptr<data_structures::Graph>& graph) {
         for (int source = 0; source < graph->getNumNodes(); source++) {
             for (auto e : *graph->getNodeAdjList(source)) {
-                
-                // the admissible graph contains only the edges with zero reduced cost
-                int cost { e.getCost() };
-                if (cost != 0) {
-                    continue;
+                if (e.getCapacity() != 1) {
+                    return false;
                 }
+            }
+        }
+
+        return true;
+    }
 
-                int sink { e.getSink() };
-                int capacity { e.getCapacity() };
-                admissible_graph->addEdge(source, sink, capacity, cost);
+    bool GraphUtils::HasZeroCosts(const std::shared_ptr<data_structures::Graph>& graph) {
+        for (int source = 0; source < graph->getNumNodes(); source++) {
+            for (auto e : *graph->getNodeAdjList(source)) {
+                if (e.getCost() != 0) {
+                    return false;
+                }
             }
         }
 
-        return admissible_graph;   
+        return true;
     }
 }
\ No newline at end of file
@@ -2,8 +2,12 @@
 #define MINIMUM_COST_FLOWS_PROBLEM_GRAPHUTILS_H
 
 #include "data_structures/graph/Graph.h"
+#include "data_structures/graph/ResidualNetwork.h"
+#include "data_structures/workspace/BfsWorkspace.h"
+#include "data_structures/workspace/DijkstraWorkspace.h"
 
 #include <string>
+#include <functional>
 
 namespace  utils {
     /**
@@ -11,6 +15,13 @@ namespace  utils {
      */
     class GraphUtils {
         public:
+            /**
+             * Function receiving the paths and the cycles of a flow decomposition (see DecomposeFlow()):
+             * the nodes crossed (a cycle ends with its first node), the flow and true for a cycle.
+             * The nodes are only valid during the call.
+             */
+            using FlowPathCallback = std::function<void(const std::vector<int>& nodes, types::capacity_t flow, bool cycle)>;
+
             /**
              * Create graph from json and return it.
              * USE THE FOLLOWING FORMAT:
@@ -39,40 +50,102 @@ namespace  utils {
              * 
              * @throws invalid_argument if the file does not exist
              * @throws invalid_argument if the json is not formatted correctly
+             * @throws invalid_argument if a capacity or a cost does not fit in its type (see types/Types.h)
              */
             static std::shared_ptr<data_structures::Graph> CreateGraphFromJSON(const std::string& filename);
 
             /**
-             * Get the residual graph of the given graph.
-             * The residual graph is a graph that indicates how much flow can be pushed through the edges.
-             * For each edge u -> v, the residual graph has an edge v -> u with capacity equal to the current pushed flow.
-             * Residual graph cannot contains anti-parallels edges, they are handled using artificial nodes.
-             * (Anti-parallel explained: https://www.hackerearth.com/practice/algorithms/graphs/maximum-flow/tutorial/)
-             * 
-             * (see: https://www.hackerearth.com/practice/algorithms/graphs/maximum-flow/tutorial/)
+             * Get the optimal graph: the edges of the graph with their flow as capacity.
              *
-             * @param graph the graph to get the residual graph from
-             * 
-             * @return the residual graph
+             * E: number of edges
+             * D: maximum out-degree
+             * Time complexity: O(E * D)
+             *
+             * @param graph      the graph
+             * @param edge_flows the flow of each edge (see GetEdgeFlows())
+             *
+             * @return the optimal graph
              */
-            static std::shared_ptr<data_structures::Graph> GetResidualGraph(const std::shared_ptr<data_structures::Graph>& graph);
+            static std::shared_ptr<data_structures::Graph> GetOptimalGraph(const std::shared_ptr<data_structures::Graph>& graph,
+                const std::vector<types::capacity_t>& edge_flows);
 
             /**
-             * Get the optimal graph.
-             * It converts te residual graph into the optimal graph.
-             * The optimal graph is the graph which contains only the starting edges with the
-             * current flow. 
+             * Get the optimal graph of the graph of a snapshot (see GetOptimalGraph(graph, edge_flows)).
              *
-             * (see: https://www.hackerearth.com/practice/algorithms/graphs/maximum-flow/tutorial/)
+             * @param snapshot   the snapshot
+             * @param edge_flows the flow of each edge (see GetEdgeFlows())
              *
-             * @param residual_graph the residual graph from which get the optimal graph
-             * @param graph          the original graph used for add the missing edges
-             * 
              * @return the optimal graph
              */
-            static std::shared_ptr<data_structures::Graph> GetOptimalGraph(const std::shared_ptr<data_structures::Graph>& residual_graph,
+            static std::shared_ptr<data_structures::Graph> GetOptimalGraph(const std::shared_ptr<data_structures::GraphSnapshot>& snapshot,
+                const std::vector<types::capacity_t>& edge_flows);
+
+            /**
+             * Get the flow of each edge of the graph from its residual network.
+             * The flows are indexed as the edges of the graph: the edges of node 0 in the order of its
+             * adjacency list, then the ones of node 1 and so on (see FlowWriter).
+             * The forward arcs leaving a node are in the order of its edges, and the flow of a forward arc
+             * is the residual capacity of its twin.
+             *
+             * V: number of nodes
+             * E: number of edges
+             * Time complexity: O(V + E)
+             *
+             * @param network the residual network of the graph with the flow
+             * @param graph   the graph
+             *
+             * @return the flow of each edge
+             */
+            static std::shared_ptr<std::vector<types::capacity_t>> GetEdgeFlows(const std::shared_ptr<data_structures::ResidualNetwork>& network,
                 const std::shared_ptr<data_structures::Graph>& graph);
 
+            /**
+             * Get the flow of each edge of the graph of a snapshot from a residual network built on it,
+             * indexed as in GetEdgeFlows(network, graph).
+             *
+             * E: number of edges
+             * Time complexity: O(E)
+             *
+             * @param network  the residual network of the snapshot with the flow
+             * @param snapshot the snapshot
+             *
+             * @return the flow of each edge
+             */
+            static std::shared_ptr<std::vector<types::capacity_t>> GetEdgeFlows(const std::shared_ptr<data_structures::ResidualNetwork>& network,
+                const std::shared_ptr<data_structures::GraphSnapshot>& snapshot);
+
+            /**
+             * Decompose a flow into source-sink paths and cycles, each with its flow, whose sum on every edge
+             * is the flow of the edge. Each path or cycle is passed to the callback as soon as it is found,
+             * so no list of paths is kept in memory.
+             * A walk follows the edges with flow left from the source (each node keeps the next edge to try,
+             * so the edges without flow are skipped once); when it reaches the sink the path gets the minimum flow
+             * of its edges, at most the net flow left out of the source, and the walk restarts from the tail of the
+             * first edge left without flow, when it reaches a node already on the walk the cycle is removed in the
+             * same way. When the source has no net flow left (the paths carry the value of the flow), the flow left
+             * is a circulation, also through the source and the sink, and it is decomposed into cycles by walks
+             * from every node.
+             * Every path or cycle removes the whole flow of at least one edge, so there are at most E of them.
+             *
+             * V: number of nodes
+             * E: number of edges
+             * P: number of paths and cycles
+             * Time complexity: O(V + E * P) (O(V + E + total length of the paths and cycles))
+             *
+             * @param graph      the graph
+             * @param edge_flows the flow of each edge (see GetEdgeFlows())
+             * @param source     the source node
+             * @param sink       the sink node
+             * @param callback   the function receiving each path and cycle
+             *
+             * @throws invalid_argument if the number of flows is not the number of edges
+             * @throws invalid_argument if the flow is not conserved at some node (except the source and the sink)
+             * @throws invalid_argument if the net flow leaving the source is negative
+             * @throws overflow_error if the net flow leaving the source overflows
+             */
+            static void DecomposeFlow(const std::shared_ptr<data_structures::Graph>& graph, const std::vector<types::capacity_t>& edge_flows,
+                int source, int sink, const FlowPathCallback& callback);
+
             /**
              * Retrieve the path from the input node to the source (node with -1 as parent).
              *
@@ -93,7 +166,7 @@ namespace  utils {
              * 
              * @return the residual capacity of the path
              */
-            static int GetResidualCapacity(const std::shared_ptr<data_structures::Graph>& residual_graph, const std::shared_ptr<std::vector<int>>& path);
+            static types::capacity_t GetResidualCapacity(const std::shared_ptr<data_structures::Graph>& residual_graph, const std::shared_ptr<std::vector<int>>& path);
 
             /**
              * Send flow in a path of edges of a residual graph with negative cost edges.
@@ -104,33 +177,99 @@ namespace  utils {
              * @param flow           the flow to send
              * 
              * @throws invalid_argument if an edge residual capacity is less than the flow to send
+             * @throws overflow_error   if a residual capacity overflows
              */
             static void SendFlowInPathNegativeCosts(const std::shared_ptr<data_structures::Graph>& residual_graph,
-                const std::shared_ptr<std::vector<int>>& path, int flow);
+                const std::shared_ptr<std::vector<int>>& path, types::capacity_t flow);
     
             /**
-             * Send flow in a path of edges of a residual graph with reduced cost edges.
-             * See the function above for more details about the graph.
+             * Retrieve the path of arcs from the source to the sink of a residual network.
              *
-             * @param residual_graph the residual residual_graph (IT MUST BE A RESIDUAL GRAPH WITH REDUCED COSTS, see the function above)
-             * @param original_graph the original graph used to recognize the residual edges
-             * @param path           the path of the edge to update
-             * @param flow           the flow to send
-             * 
-             * @throws invalid_argument if an edge residual capacity is less than the flow to send
+             * @param network    the residual network
+             * @param parent_arc the arc used to reach each node (see DijkstraResult::getParentArc())
+             * @param source     the source node of the path
+             * @param sink       the sink node of the path
+             *
+             * @return the arcs of the path from the source to the sink
              */
-            static void SendFlowInPathReducedCosts(const std::shared_ptr<data_structures::Graph>& residual_graph,
-                const std::shared_ptr<std::vector<int>>& path, int flow);
+            static std::shared_ptr<std::vector<int>> RetrieveArcPath(const std::shared_ptr<data_structures::ResidualNetwork>& network,
+                const std::shared_ptr<std::vector<int>>& parent_arc, int source, int sink);
 
             /**
-             * Get the admissible graph from a reduced cost graph.
-             * The admissible graph is the graph which contains only the edges with zero reduced cost.
+             * Retrieve the path of arcs from the source to the sink found by a bidirectional search
+             * (see GraphBaseAlgorithms::BidirectionalBFS()): the forward arcs from the source to the meeting node
+             * followed by the backward arcs from the meeting node to the sink.
              *
-             * @param graph the graph to get the admissible graph from (IT MUST BE A RESIDUAL GRAPH WITH REDUCED COSTS, see the function above)
-             * 
-             * @return the admissible graph
+             * @param network   the residual network
+             * @param workspace the workspace of the search
+             * @param source    the source node of the path
+             * @param sink      the sink node of the path
+             *
+             * @return the arcs of the path from the source to the sink
+             *
+             * @throws invalid_argument if the search did not find a path
+             */
+            static std::shared_ptr<std::vector<int>> RetrieveArcPath(const std::shared_ptr<data_structures::ResidualNetwork>& network,
+                const std::shared_ptr<data_structures::BfsWorkspace>& workspace, int source, int sink);
+
+            /**
+             * Retrieve the path of arcs from the source to the sink found by a Dijkstra search
+             * (see GraphBaseAlgorithms::Dijkstra(const std::shared_ptr<data_structures::ResidualNetwork>&, int, int,
+             * const std::shared_ptr<data_structures::DijkstraWorkspace>&)).
+             *
+             * @param network   the residual network
+             * @param workspace the workspace of the search
+             * @param source    the source node of the path
+             * @param sink      the sink node of the path
+             *
+             * @return the arcs of the path from the source to the sink
+             *
+             * @throws invalid_argument if the search did not reach the sink
+             */
+            static std::shared_ptr<std::vector<int>> RetrieveArcPath(const std::shared_ptr<data_structures::ResidualNetwork>& network,
+                const std::shared_ptr<data_structures::DijkstraWorkspace>& workspace, int source, int sink);
+
+            /**
+             * Get the residual capacity of a path of arcs of a residual network.
+             * The residual capacity is the minimum residual capacity of the arcs in the path.
+             *
+             * @param network  the residual network
+             * @param arc_path the arcs of the path
+             *
+             * @return the residual capacity of the path (0 if the path is empty)
+             */
+            static types::capacity_t GetResidualCapacity(const std::shared_ptr<data_structures::ResidualNetwork>& network,
+                const std::shared_ptr<std::vector<int>>& arc_path);
+
+            /**
+             * Send flow in a path of arcs of a residual network.
+             *
+             * @param network  the residual network
+             * @param arc_path the arcs of the path
+             * @param flow     the flow to send
+             *
+             * @throws invalid_argument if an arc residual capacity is less than the flow to send
+             */
+            static void SendFlowInArcPath(const std::shared_ptr<data_structures::ResidualNetwork>& network,
+                const std::shared_ptr<std::vector<int>>& arc_path, types::capacity_t flow);
+
+            /**
+             * Check if every edge of the graph has capacity 1.
+             *
+             * @param graph the graph to check
+             *
+             * @return true if every edge has capacity 1, false otherwise
+             */
+            static bool HasUnitCapacities(const std::shared_ptr<data_structures::Graph>& graph);
+
+            /**
+             * Check if every edge of the graph has cost 0.
+             *
+             * @param graph the graph to check
+             *
+             * @return true if every edge has cost 0, false otherwise
              */
-            static std::shared_ptr<data_structures::Graph> GetAdmissibleGraph(const std::shared_ptr<data_structures::Graph>& graph);
+            static bool HasZeroCosts(const std::shared_ptr<data_structures::Graph>& graph);
     };
 }
 
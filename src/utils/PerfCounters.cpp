@@ -0,0 +1,89 @@
+#include "PerfCounters.h"
+
+#include <iterator>
+
+#ifdef NETWORK_FLOWS_PERF
+#include <cstdint>
+#include <cstring>
+
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+namespace utils {
+    namespace {
+        // names of the events, in the order of the enum
+        const char* const event_names[] { "cycles", "instructions", "llc_misses", "branch_misses" };
+
+        static_assert(std::size(event_names) == static_cast<std::size_t>(PerfCounters::Event::Count));
+
+#ifdef NETWORK_FLOWS_PERF
+        /**
+         * File descriptors of the counters of a thread.
+         * Each event is opened on its own, not as a group, so that an event the CPU does not support
+         * does not disable the others.
+         */
+        class ThreadCounters {
+            public:
+                ThreadCounters() {
+                    const std::uint64_t configs[] { PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                        PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES };
+
+                    for (std::size_t event = 0; event < this->fds.size(); event++) {
+                        perf_event_attr attributes {};
+                        std::memset(&attributes, 0, sizeof(attributes));
+                        attributes.size = sizeof(attributes);
+                        attributes.type = PERF_TYPE_HARDWARE;
+                        attributes.config = configs[event];
+                        attributes.exclude_kernel = 1;
+                        attributes.exclude_hv = 1;
+
+                        // calling thread, any CPU, no group
+                        this->fds[event] = static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+                    }
+                }
+
+                ~ThreadCounters() {
+                    for (int fd : this->fds) {
+                        if (fd != -1) {
+                            close(fd);
+                        }
+                    }
+                }
+
+                ThreadCounters(const ThreadCounters&) = delete;
+                ThreadCounters& operator=(const ThreadCounters&) = delete;
+
+                PerfCounters::Values read() const {
+                    PerfCounters::Values values {};
+                    for (std::size_t event = 0; event < this->fds.size(); event++) {
+                        std::uint64_t value {};
+                        bool valid { this->fds[event] != -1 &&
+                            ::read(this->fds[event], &value, sizeof(value)) == static_cast<ssize_t>(sizeof(value)) };
+                        values[event] = valid ? static_cast<long long>(value) : -1;
+                    }
+                    return values;
+                }
+
+            private:
+                std::array<int, static_cast<int>(PerfCounters::Event::Count)> fds {};
+        };
+#endif
+    }
+
+    PerfCounters::Values PerfCounters::Read() {
+#ifdef NETWORK_FLOWS_PERF
+        thread_local ThreadCounters counters {};
+        return counters.read();
+#else
+        Values values {};
+        values.fill(-1);
+        return values;
+#endif
+    }
+
+    const char* PerfCounters::GetName(Event event) {
+        return event_names[static_cast<int>(event)];
+    }
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+#ifndef MINIMUM_COST_FLOWS_PROBLEM_PERFCOUNTERS_H
+#define MINIMUM_COST_FLOWS_PROBLEM_PERFCOUNTERS_H
+
+#include <array>
+
+namespace utils {
+    /**
+     * Hardware counters of the calling thread, read with the Linux perf_event_open() system call
+     * (user space only). Every thread opens its counters at its first read and keeps them until it exits.
+     * They are read only when the project is built with NETWORK_FLOWS_PERF (see utils::Stats), otherwise
+     * no event is available. An event that cannot be opened (e.g. a virtual machine without a PMU,
+     * or /proc/sys/kernel/perf_event_paranoid too high) is not available and is not reported.
+     *
+     * (see: https://man7.org/linux/man-pages/man2/perf_event_open.2.html)
+     */
+    class PerfCounters {
+        public:
+            /**
+             * Hardware events.
+             */
+            enum class Event {
+                Cycles,         // CPU cycles
+                Instructions,   // retired instructions
+                LlcMisses,      // last level cache misses
+                BranchMisses,   // mispredicted branches
+                Count
+            };
+
+            // value of each event (-1 if the event is not available)
+            using Values = std::array<long long, static_cast<int>(Event::Count)>;
+
+            /**
+             * Read the events of the calling thread: the difference between two reads
+             * is the number of events between them.
+             *
+             * @return the value of each event
+             */
+            static Values Read();
+
+            /**
+             * Get the name of an event.
+             *
+             * @param event the event
+             *
+             * @return the name of the event (e.g. "llc_misses")
+             */
+            static const char* GetName(Event event);
+    };
+}
+
+#endif //MINIMUM_COST_FLOWS_PROBLEM_PERFCOUNTERS_H
@@ -0,0 +1,132 @@
+#include "Stats.h"
+
+#include <map>
+#include <iterator>
+#include <string>
+
+namespace utils {
+    namespace {
+        // names of the counters and of the phases, in the order of the enums
+        const char* const counter_names[] {
+            "bfs_calls", "dijkstra_calls", "bellman_ford_calls", "nodes_scanned", "arcs_relaxed", "augmentations",
+            "cycles_cancelled", "iterations", "pushes", "relabels", "global_relabels"
+        };
+        const char* const phase_names[] {
+            "residual_network", "negative_cycle", "max_flow", "shortest_paths", "admissible_graph", "flow_update",
+            "global_relabel", "min_cut", "solution", "solve"
+        };
+
+        static_assert(std::size(counter_names) == static_cast<std::size_t>(Stats::Counter::Count));
+        static_assert(std::size(phase_names) == static_cast<std::size_t>(Stats::Phase::Count));
+
+        // depth of the nested scopes of the calling thread
+        thread_local int scope_depth { 0 };
+    }
+
+    void Stats::AddTime(Phase phase, std::chrono::nanoseconds duration) {
+        auto& nanoseconds = Stats::local().nanoseconds[static_cast<int>(phase)];
+        nanoseconds.store(nanoseconds.load(std::memory_order_relaxed) + duration.count(), std::memory_order_relaxed);
+    }
+
+    void Stats::AddEvents(Phase phase, const PerfCounters::Values& start, const PerfCounters::Values& end) {
+        auto& events = Stats::local().events[static_cast<int>(phase)];
+        for (std::size_t event = 0; event < events.size(); event++) {
+            if (start[event] != -1 && end[event] != -1) {
+                events[event].store(events[event].load(std::memory_order_relaxed) + end[event] - start[event], std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void Stats::Reset() {
+        std::lock_guard<std::mutex> lock(Stats::registryMutex());
+        for (auto& thread_stats : Stats::registry()) {
+            for (auto& counter : thread_stats->counters) {
+                counter.store(0, std::memory_order_relaxed);
+            }
+            for (auto& nanoseconds : thread_stats->nanoseconds) {
+                nanoseconds.store(0, std::memory_order_relaxed);
+            }
+            for (auto& phase_events : thread_stats->events) {
+                for (auto& events : phase_events) {
+                    events.store(0, std::memory_order_relaxed);
+                }
+            }
+        }
+    }
+
+    std::shared_ptr<dto::SolverStats> Stats::Snapshot() {
+        std::array<long long, static_cast<int>(Counter::Count)> counters {};
+        std::array<long long, static_cast<int>(Phase::Count)> nanoseconds {};
+        std::array<std::array<long long, static_cast<int>(PerfCounters::Event::Count)>, static_cast<int>(Phase::Count)> events {};
+        {
+            std::lock_guard<std::mutex> lock(Stats::registryMutex());
+            for (auto& thread_stats : Stats::registry()) {
+                for (std::size_t i = 0; i < counters.size(); i++) {
+                    counters[i] += thread_stats->counters[i].load(std::memory_order_relaxed);
+                }
+                for (std::size_t i = 0; i < nanoseconds.size(); i++) {
+                    nanoseconds[i] += thread_stats->nanoseconds[i].load(std::memory_order_relaxed);
+                    for (std::size_t event = 0; event < events[i].size(); event++) {
+                        events[i][event] += thread_stats->events[i][event].load(std::memory_order_relaxed);
+                    }
+                }
+            }
+        }
+
+        std::map<std::string, long long> counter_values {};
+        for (std::size_t i = 0; i < counters.size(); i++) {
+            counter_values.emplace(counter_names[i], counters[i]);
+        }
+        std::map<std::string, double> phase_times {};
+        for (std::size_t i = 0; i < nanoseconds.size(); i++) {
+            phase_times.emplace(phase_names[i], static_cast<double>(nanoseconds[i]) / 1e6);
+        }
+
+        // only the phases that ran and the events that are available are reported
+        std::map<std::string, std::map<std::string, long long>> phase_events {};
+        auto available = PerfCounters::Read();
+        for (std::size_t i = 0; i < nanoseconds.size(); i++) {
+            if (nanoseconds[i] == 0) {
+                continue;
+            }
+            for (std::size_t event = 0; event < events[i].size(); event++) {
+                if (available[event] != -1) {
+                    phase_events[phase_names[i]].emplace(PerfCounters::GetName(static_cast<PerfCounters::Event>(event)), events[i][event]);
+                }
+            }
+        }
+
+        return std::make_shared<dto::SolverStats>(std::move(counter_values), std::move(phase_times), std::move(phase_events));
+    }
+
+    Stats::ThreadStats& Stats::local() {
+        thread_local std::shared_ptr<ThreadStats> stats { [] {
+            auto thread_stats = std::make_shared<ThreadStats>();
+            std::lock_guard<std::mutex> lock(Stats::registryMutex());
+            Stats::registry().push_back(thread_stats);
+            return thread_stats;
+        }() };
+        return *stats;
+    }
+
+    std::vector<std::shared_ptr<Stats::ThreadStats>>& Stats::registry() {
+        static std::vector<std::shared_ptr<ThreadStats>> registry {};
+        return registry;
+    }
+
+    std::mutex& Stats::registryMutex() {
+        static std::mutex mutex {};
+        return mutex;
+    }
+
+    StatsScope::StatsScope() : outermost(scope_depth++ == 0) {
+        if (this->outermost) {
+            Stats::Reset();
+            this->timer.emplace(Stats::Phase::Solve);
+        }
+    }
+
+    StatsScope::~StatsScope() {
+        scope_depth--;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,237 @@
+#ifndef MINIMUM_COST_FLOWS_PROBLEM_STATS_H
+#define MINIMUM_COST_FLOWS_PROBLEM_STATS_H
+
+#include "PerfCounters.h"
+#include "dto/solverStats/SolverStats.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace utils {
+    /**
+     * Statistics of the algorithms: counters of the work done and wall time of the phases.
+     * They are collected only when the project is built with NETWORK_FLOWS_STATS, otherwise the
+     * NETWORK_FLOWS_STATS_* macros below expand to nothing and the algorithms pay nothing.
+     *
+     * Every thread (including the workers of utils::ThreadPool) adds to its own counters, so the hot loops
+     * never share a cache line; a snapshot sums the counters of all the threads.
+     * The outermost StatsScope of a run resets the counters and attaches the snapshot to the result,
+     * the statistics of runs executed at the same time by different threads are mixed.
+     *
+     * With NETWORK_FLOWS_PERF (Linux) the timers also read the hardware counters of their thread
+     * (see utils::PerfCounters): the work done by the other threads of utils::ThreadPool during a phase
+     * is not counted, so the parallel algorithms are profiled with one thread.
+     */
+    class Stats {
+        public:
+            /**
+             * Counters.
+             */
+            enum class Counter {
+                BfsCalls,           // breadth-first searches
+                DijkstraCalls,      // Dijkstra and delta-stepping searches
+                BellmanFordCalls,   // Bellman-Ford searches
+                NodesScanned,       // nodes whose arcs were scanned by a search
+                ArcsRelaxed,        // arcs scanned by a search
+                Augmentations,      // paths along which flow was sent
+                CyclesCancelled,    // negative cycles cancelled
+                Iterations,         // iterations (phases) of the minimum cost algorithms
+                Pushes,             // pushes of Push-Relabel
+                Relabels,           // relabels of Push-Relabel
+                GlobalRelabels,     // global relabels of Push-Relabel
+                Count
+            };
+
+            /**
+             * Phases.
+             */
+            enum class Phase {
+                ResidualNetwork,    // building the residual network
+                NegativeCycle,      // searching negative cycles
+                MaxFlow,            // computing a maximum flow
+                ShortestPaths,      // computing shortest paths
+                AdmissibleGraph,    // updating the potentials that define the admissible arcs
+                FlowUpdate,         // sending flow on the residual network
+                GlobalRelabel,      // global relabels of Push-Relabel
+                MinCut,             // computing the minimum cut
+                Solution,           // building the result
+                Solve,              // the whole run
+                Count
+            };
+
+            /**
+             * Add a value to a counter of the calling thread.
+             *
+             * @param counter the counter
+             * @param value   the value to add
+             */
+            static void Add(Counter counter, long long value) {
+                auto& local_counter = Stats::local().counters[static_cast<int>(counter)];
+                // only the owner thread writes its counters, no atomic read-modify-write is needed
+                local_counter.store(local_counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+            }
+
+            /**
+             * Add a wall time to a phase of the calling thread.
+             *
+             * @param phase    the phase
+             * @param duration the wall time
+             */
+            static void AddTime(Phase phase, std::chrono::nanoseconds duration);
+
+            /**
+             * Add the hardware events counted by the calling thread to a phase.
+             *
+             * @param phase the phase
+             * @param start the value of the events at the start of the phase (see utils::PerfCounters::Read())
+             * @param end   the value of the events at the end of the phase
+             */
+            static void AddEvents(Phase phase, const PerfCounters::Values& start, const PerfCounters::Values& end);
+
+            /**
+             * Set every counter and phase time of every thread to zero.
+             */
+            static void Reset();
+
+            /**
+             * Get the sum of the counters and of the phase times of all the threads.
+             *
+             * @return the statistics
+             */
+            static std::shared_ptr<dto::SolverStats> Snapshot();
+
+        private:
+            /**
+             * Counters and phase times of a thread.
+             */
+            struct ThreadStats {
+                std::array<std::atomic<long long>, static_cast<int>(Counter::Count)> counters {};
+                std::array<std::atomic<long long>, static_cast<int>(Phase::Count)> nanoseconds {};
+                std::array<std::array<std::atomic<long long>, static_cast<int>(PerfCounters::Event::Count)>,
+                    static_cast<int>(Phase::Count)> events {};
+            };
+
+            /**
+             * Get the statistics of the calling thread, registered at the first call.
+             *
+             * @return the statistics of the calling thread
+             */
+            static ThreadStats& local();
+
+            /**
+             * Get the statistics of every thread that ever added to a counter, they are never removed
+             * so that the statistics of the threads that exited are still summed.
+             *
+             * @return the statistics of the threads
+             */
+            static std::vector<std::shared_ptr<ThreadStats>>& registry();
+
+            /**
+             * Get the mutex of the registry.
+             *
+             * @return the mutex
+             */
+            static std::mutex& registryMutex();
+    };
+
+    /**
+     * Adds the wall time (and with NETWORK_FLOWS_PERF the hardware events of the thread)
+     * from its construction to its destruction (or to stop()) to a phase.
+     */
+    class ScopedTimer {
+        public:
+            explicit ScopedTimer(Stats::Phase phase) : phase(phase), running(true) {
+#ifdef NETWORK_FLOWS_PERF
+                this->start_events = PerfCounters::Read();
+#endif
+                this->start = std::chrono::steady_clock::now();
+            }
+
+            ~ScopedTimer() { this->stop(); }
+
+            ScopedTimer(const ScopedTimer&) = delete;
+            ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+            /**
+             * Stop the timer before the end of the scope.
+             */
+            void stop() {
+                if (this->running) {
+                    Stats::AddTime(this->phase, std::chrono::steady_clock::now() - this->start);
+#ifdef NETWORK_FLOWS_PERF
+                    Stats::AddEvents(this->phase, this->start_events, PerfCounters::Read());
+#endif
+                    this->running = false;
+                }
+            }
+
+        private:
+            Stats::Phase phase;
+            std::chrono::steady_clock::time_point start;
+            PerfCounters::Values start_events {};
+            bool running;
+    };
+
+    /**
+     * Scope of a run of a public algorithm. Only the outermost scope of the thread (e.g. PrimalDual()
+     * and not the EdmondsKarp() it calls) resets the statistics, times the whole run (Stats::Phase::Solve)
+     * and attaches the statistics to the result.
+     */
+    class StatsScope {
+        public:
+            StatsScope();
+
+            ~StatsScope();
+
+            StatsScope(const StatsScope&) = delete;
+            StatsScope& operator=(const StatsScope&) = delete;
+
+            /**
+             * Attach the statistics to the result if this is the outermost scope.
+             *
+             * @tparam Result a result with a setStats() method (e.g. dto::FlowResult)
+             *
+             * @param result the result
+             *
+             * @return the result
+             */
+            template <typename Result>
+            std::shared_ptr<Result> attach(std::shared_ptr<Result> result) {
+                if (this->outermost) {
+                    this->timer->stop();
+                    result->setStats(Stats::Snapshot());
+                }
+                return result;
+            }
+
+        private:
+            bool outermost;
+            std::optional<ScopedTimer> timer;
+    };
+}
+
+#ifdef NETWORK_FLOWS_STATS
+    // add a value to a counter, e.g. NETWORK_FLOWS_STATS_ADD(Augmentations, 1)
+    #define NETWORK_FLOWS_STATS_ADD(counter, value) utils::Stats::Add(utils::Stats::Counter::counter, (value))
+    // time a phase until the end of the scope, e.g. NETWORK_FLOWS_STATS_TIMER(timer, MaxFlow)
+    #define NETWORK_FLOWS_STATS_TIMER(name, phase) utils::ScopedTimer name(utils::Stats::Phase::phase)
+    // stop a timer before the end of its scope
+    #define NETWORK_FLOWS_STATS_STOP(name) name.stop()
+    // open the scope of a run of a public algorithm
+    #define NETWORK_FLOWS_STATS_SCOPE(name) utils::StatsScope name
+    // attach the statistics of the scope to a result and return it
+    #define NETWORK_FLOWS_STATS_RESULT(name, result) name.attach(result)
+#else
+    #define NETWORK_FLOWS_STATS_ADD(counter, value) ((void)0)
+    #define NETWORK_FLOWS_STATS_TIMER(name, phase) ((void)0)
+    #define NETWORK_FLOWS_STATS_STOP(name) ((void)0)
+    #define NETWORK_FLOWS_STATS_SCOPE(name) ((void)0)
+    #define NETWORK_FLOWS_STATS_RESULT(name, result) (result)
+#endif
+
+#endif //MINIMUM_COST_FLOWS_PROBLEM_STATS_H
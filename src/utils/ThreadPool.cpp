@@ -0,0 +1,240 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace utils {
+    namespace {
+        std::uint64_t packRange(int begin, int end) {
+            return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(begin)) << 32) | static_cast<std::uint32_t>(end);
+        }
+
+        int rangeBegin(std::uint64_t range) {
+            return static_cast<int>(range >> 32);
+        }
+
+        int rangeEnd(std::uint64_t range) {
+            return static_cast<int>(range & 0xFFFFFFFFu);
+        }
+
+        // true while the thread runs the body of a parallel loop
+        thread_local bool in_parallel_loop { false };
+
+        // mark the thread as running a parallel loop until the end of the scope (even if the body throws)
+        struct ParallelLoopScope {
+            ParallelLoopScope() { in_parallel_loop = true; }
+            ~ParallelLoopScope() { in_parallel_loop = false; }
+        };
+    }
+
+    std::mutex ThreadPool::instance_mutex {};
+    std::shared_ptr<ThreadPool> ThreadPool::instance {};
+    int ThreadPool::instance_num_threads { 0 };
+
+    ThreadPool::ThreadPool(int num_threads) :
+        num_threads(num_threads),
+        body(nullptr),
+        grain(1),
+        generation(0),
+        pending_workers(0),
+        stopping(false) {
+
+        if (num_threads <= 0) {
+            throw std::invalid_argument("the number of threads must be positive");
+        }
+
+        this->ranges = std::make_unique<std::atomic<std::uint64_t>[]>(num_threads);
+        for (int thread = 0; thread < num_threads; thread++) {
+            this->ranges[thread].store(packRange(0, 0));
+        }
+
+        for (int thread = 1; thread < num_threads; thread++) {
+            this->workers.emplace_back(&ThreadPool::workerLoop, this, thread);
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->stopping = true;
+        }
+        this->start_condition.notify_all();
+
+        for (auto& worker : this->workers) {
+            worker.join();
+        }
+    }
+
+    int ThreadPool::getNumThreads() const {
+        return this->num_threads;
+    }
+
+    void ThreadPool::parallelFor(int size, int grain, const std::function<void(int, int, int)>& body) {
+        if (size <= 0) {
+            return;
+        }
+
+        // nothing to share, or called by the body of a parallel loop (the workers are busy)
+        if (this->num_threads == 1 || size <= grain || in_parallel_loop) {
+            body(0, size, 0);
+            return;
+        }
+
+        std::lock_guard<std::mutex> run_lock(this->run_mutex);
+
+        // split the iterations in one contiguous range per thread
+        for (int thread = 0; thread < this->num_threads; thread++) {
+            int begin { static_cast<int>(static_cast<long long>(size) * thread / this->num_threads) };
+            int end { static_cast<int>(static_cast<long long>(size) * (thread + 1) / this->num_threads) };
+            this->ranges[thread].store(packRange(begin, end));
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->body = &body;
+            this->grain = std::max(grain, 1);
+            this->error = nullptr;
+            this->pending_workers = this->num_threads - 1;
+            this->generation++;
+        }
+        this->start_condition.notify_all();
+
+        // the calling thread works as thread 0
+        try {
+            this->runRanges(0);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            if (!this->error) {
+                this->error = std::current_exception();
+            }
+        }
+
+        // wait for the workers
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->done_condition.wait(lock, [this] { return this->pending_workers == 0; });
+        this->body = nullptr;
+
+        if (this->error) {
+            std::rethrow_exception(this->error);
+        }
+    }
+
+    std::shared_ptr<ThreadPool> ThreadPool::GetInstance() {
+        std::lock_guard<std::mutex> lock(ThreadPool::instance_mutex);
+
+        if (!ThreadPool::instance) {
+            int num_threads { ThreadPool::instance_num_threads };
+            if (num_threads <= 0) {
+                num_threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+            }
+            ThreadPool::instance = std::make_shared<ThreadPool>(num_threads);
+        }
+
+        return ThreadPool::instance;
+    }
+
+    bool ThreadPool::InParallelLoop() {
+        return in_parallel_loop;
+    }
+
+    void ThreadPool::SetNumThreads(int num_threads) {
+        if (num_threads <= 0) {
+            throw std::invalid_argument("the number of threads must be positive");
+        }
+
+        std::lock_guard<std::mutex> lock(ThreadPool::instance_mutex);
+        ThreadPool::instance_num_threads = num_threads;
+
+        // the algorithms still using the old pool keep it alive
+        ThreadPool::instance.reset();
+    }
+
+    void ThreadPool::workerLoop(int thread) {
+        std::uint64_t seen_generation { 0 };
+
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(this->mutex);
+                this->start_condition.wait(lock, [this, seen_generation] {
+                    return this->stopping || this->generation != seen_generation;
+                });
+                if (this->stopping) {
+                    return;
+                }
+                seen_generation = this->generation;
+            }
+
+            try {
+                this->runRanges(thread);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                if (!this->error) {
+                    this->error = std::current_exception();
+                }
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                this->pending_workers--;
+            }
+            this->done_condition.notify_one();
+        }
+    }
+
+    void ThreadPool::runRanges(int thread) {
+        ParallelLoopScope scope {};
+        int begin {};
+        int end {};
+
+        while (true) {
+            if (this->popChunk(thread, begin, end)) {
+                (*this->body)(begin, end, thread);
+            } else if (!this->steal(thread)) {
+                return;
+            }
+        }
+    }
+
+    bool ThreadPool::popChunk(int thread, int& begin, int& end) {
+        std::uint64_t range { this->ranges[thread].load() };
+
+        while (true) {
+            int range_begin { rangeBegin(range) };
+            int range_end { rangeEnd(range) };
+            if (range_begin >= range_end) {
+                return false;
+            }
+
+            int chunk_end { std::min(range_end, range_begin + this->grain) };
+            if (this->ranges[thread].compare_exchange_weak(range, packRange(chunk_end, range_end))) {
+                begin = range_begin;
+                end = chunk_end;
+                return true;
+            }
+        }
+    }
+
+    bool ThreadPool::steal(int thread) {
+        for (int i = 1; i < this->num_threads; i++) {
+            int victim { (thread + i) % this->num_threads };
+            std::uint64_t range { this->ranges[victim].load() };
+
+            while (true) {
+                int range_begin { rangeBegin(range) };
+                int range_end { rangeEnd(range) };
+                if (range_begin >= range_end) {
+                    break;
+                }
+
+                // steal the second half (all of it if it is a single chunk)
+                int middle { range_end - range_begin > this->grain ? range_begin + (range_end - range_begin) / 2 : range_begin };
+                if (this->ranges[victim].compare_exchange_weak(range, packRange(range_begin, middle))) {
+                    this->ranges[thread].store(packRange(middle, range_end));
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,157 @@
+#ifndef MINIMUM_COST_FLOWS_PROBLEM_THREADPOOL_H
+#define MINIMUM_COST_FLOWS_PROBLEM_THREADPOOL_H
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+
+namespace utils {
+    /**
+     * Pool of worker threads used by the parallel algorithms.
+     * A parallel loop over [0, size) is split in one contiguous range per thread, each thread
+     * takes chunks from the front of its own range and, when it is empty, steals half of the
+     * remaining range of another thread (work stealing), so unbalanced iterations do not leave
+     * threads idle. The ranges are updated with compare-and-swap, without locks.
+     *
+     * The thread calling parallelFor() takes part in the loop as thread 0.
+     */
+    class ThreadPool {
+        public:
+            /**
+             * Thread pool constructor.
+             *
+             * @param num_threads the number of threads (including the calling thread)
+             *
+             * @throws invalid_argument if the number of threads is not positive
+             */
+            explicit ThreadPool(int num_threads);
+
+            /**
+             * Stop and join the worker threads.
+             */
+            ~ThreadPool();
+
+            ThreadPool(const ThreadPool&) = delete;
+            ThreadPool& operator=(const ThreadPool&) = delete;
+
+            /**
+             * Get the number of threads (including the calling thread).
+             *
+             * @return the number of threads
+             */
+            [[nodiscard]] int getNumThreads() const;
+
+            /**
+             * Run body(begin, end, thread) over chunks of [0, size) of at most grain iterations,
+             * and return when all the iterations are done.
+             * The calls to parallelFor() are serialized, a call made by body runs the whole loop
+             * on the calling thread (as thread 0), so an algorithm can run inside a parallel loop.
+             *
+             * @param size  the number of iterations
+             * @param grain the maximum number of iterations of a chunk
+             * @param body  the function applied to each chunk, thread is in [0, getNumThreads())
+             *
+             * @throws the first exception thrown by body
+             */
+            void parallelFor(int size, int grain, const std::function<void(int, int, int)>& body);
+
+            /**
+             * Get the pool shared by the algorithms.
+             * It is created on the first call with the number of threads set using SetNumThreads()
+             * (by default the number of hardware threads).
+             *
+             * @return the shared pool
+             */
+            static std::shared_ptr<ThreadPool> GetInstance();
+
+            /**
+             * Check if the calling thread is running the body of a parallel loop,
+             * where parallelFor() runs serially (see parallelFor()).
+             *
+             * @return true if the calling thread is inside a parallel loop, false otherwise
+             */
+            [[nodiscard]] static bool InParallelLoop();
+
+            /**
+             * Set the number of threads of the shared pool, the pool is recreated on the next GetInstance().
+             *
+             * @param num_threads the number of threads (1 disables the parallel algorithms)
+             *
+             * @throws invalid_argument if the number of threads is not positive
+             */
+            static void SetNumThreads(int num_threads);
+
+        private:
+            /**
+             * Loop run by the worker threads: wait for a parallel loop and take part in it.
+             *
+             * @param thread the id of the worker thread
+             */
+            void workerLoop(int thread);
+
+            /**
+             * Run the chunks of the own range, then steal from the other threads until no work is left.
+             *
+             * @param thread the id of the thread
+             */
+            void runRanges(int thread);
+
+            /**
+             * Take a chunk from the front of the range of a thread.
+             *
+             * @param thread the thread owning the range
+             * @param begin  the begin of the chunk
+             * @param end    the end of the chunk
+             *
+             * @return true if a chunk was taken, false if the range is empty
+             */
+            bool popChunk(int thread, int& begin, int& end);
+
+            /**
+             * Move half of the remaining range of another thread to the range of the thread.
+             *
+             * @param thread the thief thread
+             *
+             * @return true if some work was stolen, false if no thread has work left
+             */
+            bool steal(int thread);
+
+            // number of threads, including the calling thread
+            int num_threads;
+
+            // worker threads (ids from 1 to num_threads - 1)
+            std::vector<std::thread> workers;
+
+            // remaining range of each thread, packed as (begin << 32) | end
+            std::unique_ptr<std::atomic<std::uint64_t>[]> ranges;
+
+            // current parallel loop
+            const std::function<void(int, int, int)>* body;
+            int grain;
+
+            // synchronization of the workers
+            std::mutex mutex;
+            std::mutex run_mutex;
+            std::condition_variable start_condition;
+            std::condition_variable done_condition;
+            std::uint64_t generation;
+            int pending_workers;
+            bool stopping;
+
+            // first exception thrown by the body
+            std::exception_ptr error;
+
+            // shared pool
+            static std::mutex instance_mutex;
+            static std::shared_ptr<ThreadPool> instance;
+            static int instance_num_threads;
+    };
+}
+
+#endif //MINIMUM_COST_FLOWS_PROBLEM_THREADPOOL_H
@@ -0,0 +1,71 @@
+#include "TestUtils.h"
+
+#include "utils/json.hpp"
+#include "cli/BatchRunner.h"
+
+#include <cstdlib>
+#include <sstream>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+using json = nlohmann::ordered_json;
+
+namespace {
+    /**
+     * Solve the file in batch mode and return the value of the solution, or its error.
+     */
+    std::string solve(const std::string& file, const std::string& algorithm, bool components) {
+        std::vector<std::string> arguments { "network_flows", "--algorithm", algorithm, "--threads", "4", file };
+        if (components) {
+            arguments.emplace_back("--components");
+        }
+        std::vector<char*> argv {};
+        for (auto& argument : arguments) {
+            argv.push_back(argument.data());
+        }
+
+        std::ostringstream output {};
+        auto buffer = std::cout.rdbuf(output.rdbuf());
+        cli::BatchRunner::Run(static_cast<int>(argv.size()), argv.data());
+        std::cout.rdbuf(buffer);
+
+        auto line = json::parse(output.str());
+        return line.contains("error") ? "error: " + line["error"].get<std::string>() : std::to_string(line["value"].get<long long>());
+    }
+}
+
+/**
+ * The option --components only changes the speed: for every algorithm the value of each solution
+ * (or its error) must be the same with and without it. The random graphs are sparse, so they have many components,
+ * with negative costs (and negative cycles) inside and outside the component of the source.
+ */
+int main() {
+    const std::vector<std::string> algorithms { "edmonds-karp", "push-relabel", "cycle-cancelling",
+        "successive-shortest-path", "primal-dual" };
+    const std::string file { "components_test.json" };
+    bool passed { true };
+
+    for (unsigned seed = 100; seed < 200; seed++) {
+        auto graph = tests::TestUtils::RandomGraph(seed, 12, 10 + static_cast<int>(seed % 8), 9, -20, 20);
+
+        json edges = json::array();
+        for (int node = 0; node < graph->getNumNodes(); node++) {
+            for (const auto& e : *graph->getNodeAdjList(node)) {
+                edges.push_back({ { "Source", e.getSource() }, { "Sink", e.getSink() },
+                    { "Capacity", e.getCapacity() }, { "Cost", e.getCost() } });
+            }
+        }
+        std::ofstream(file) << json { { "Num_nodes", graph->getNumNodes() }, { "Edges", edges } }.dump();
+
+        for (const auto& algorithm : algorithms) {
+            auto plain = solve(file, algorithm, false);
+            auto components = solve(file, algorithm, true);
+            passed &= tests::TestUtils::Check(plain == components, "seed " + std::to_string(seed) + ", " + algorithm
+                + ": " + plain + " without --components, " + components + " with --components");
+        }
+    }
+
+    std::remove(file.c_str());
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,85 @@
+#include "TestUtils.h"
+
+#include "utils/GraphUtils.h"
+
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <exception>
+
+namespace {
+    /**
+     * Decompose the flow and check that the paths carry the value of the flow, that every path goes from
+     * the source to the sink, that every cycle is closed and that the sum on every edge is the flow of the edge.
+     */
+    bool checkDecomposition(const std::string& name, const std::shared_ptr<data_structures::Graph>& graph,
+        const std::vector<types::capacity_t>& edge_flows, int source, int sink, types::accumulator_t value) {
+
+        // the index of each edge by its nodes
+        std::vector<std::vector<std::pair<int, std::size_t>>> edges(graph->getNumNodes());
+        std::size_t num_edges {};
+        for (int node = 0; node < graph->getNumNodes(); node++) {
+            for (const auto& e : *graph->getNodeAdjList(node)) {
+                edges[node].emplace_back(e.getSink(), num_edges++);
+            }
+        }
+
+        std::vector<types::capacity_t> sum(num_edges, 0);
+        types::accumulator_t paths_flow {};
+        bool passed { true };
+        try {
+            utils::GraphUtils::DecomposeFlow(graph, edge_flows, source, sink,
+                [&](const std::vector<int>& nodes, types::capacity_t flow, bool cycle) {
+                    passed &= tests::TestUtils::Check(flow > 0, name + ": path or cycle without flow");
+                    if (cycle) {
+                        passed &= tests::TestUtils::Check(nodes.front() == nodes.back(), name + ": open cycle");
+                    } else {
+                        passed &= tests::TestUtils::Check(nodes.front() == source && nodes.back() == sink,
+                            name + ": path not from the source to the sink");
+                        paths_flow += flow;
+                    }
+                    for (std::size_t i = 0; i + 1 < nodes.size(); i++) {
+                        for (const auto& [head, edge] : edges[nodes[i]]) {
+                            if (head == nodes[i + 1]) {
+                                sum[edge] += flow;
+                            }
+                        }
+                    }
+                });
+        } catch (std::exception& e) {
+            return tests::TestUtils::Check(false, name + ": " + e.what());
+        }
+
+        passed &= tests::TestUtils::Check(paths_flow == value, name + ": the paths carry " + std::to_string(paths_flow)
+            + " instead of " + std::to_string(value));
+        passed &= tests::TestUtils::Check(sum == edge_flows, name + ": the sum on the edges is not the flow");
+        return passed;
+    }
+}
+
+/**
+ * The decomposition of a flow into paths and cycles (see utils::GraphUtils::DecomposeFlow()) accepts every
+ * valid flow, also when a cycle goes through the source and the sink.
+ */
+int main() {
+    bool passed { true };
+
+    // s -> t = 2 and t -> s = 1: a path of 1 and the cycle s -> t -> s of 1
+    auto graph = std::make_shared<data_structures::Graph>(2);
+    graph->addEdge(0, 1, 5, 1);
+    graph->addEdge(1, 0, 5, 1);
+    passed &= checkDecomposition("s <-> t", graph, { 2, 1 }, 0, 1, 1);
+
+    // a cycle through the source and the sink (0 -> 1 -> 3 -> 2 -> 0) on top of the path 0 -> 1 -> 3
+    graph = std::make_shared<data_structures::Graph>(4);
+    graph->addEdge(0, 1, 9, 1);
+    graph->addEdge(1, 3, 9, 1);
+    graph->addEdge(3, 2, 9, 1);
+    graph->addEdge(2, 0, 9, 1);
+    passed &= checkDecomposition("cycle through s and t", graph, { 5, 5, 3, 3 }, 0, 3, 2);
+
+    // only a circulation through the source and the sink: no path
+    passed &= checkDecomposition("circulation", graph, { 4, 4, 4, 4 }, 0, 3, 0);
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
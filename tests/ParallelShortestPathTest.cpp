@@ -0,0 +1,41 @@
+#include "TestUtils.h"
+
+#include "utils/ThreadPool.h"
+#include "algorithms/MinimumCostFlowAlgorithms.h"
+
+#include <limits>
+#include <cstdlib>
+#include <exception>
+
+/**
+ * The parallel shortest paths (see algorithms::ParallelShortestPathAlgorithms) solve the graphs solved by the
+ * sequential ones: on a large graph with costs scaled to the cost type the minimum cost algorithms must give
+ * the same value with one thread and with the parallel path forced by four threads.
+ */
+int main() {
+    // 80 000 residual arcs, above consts::parallel_min_arcs, every cost about 1e15 with 64-bit costs:
+    // the distances of the paths of 300 nodes and the total cost still fit in the accumulator
+    const types::cost_t cost { std::numeric_limits<types::cost_t>::max() / 8192 };
+    auto graph = tests::TestUtils::RandomGraph(29, 300, 40000, 3, cost, cost);
+    int source { 0 };
+    int sink { graph->getNumNodes() - 1 };
+    bool passed { true };
+
+    for (const auto& [name, algorithm] : {
+        std::make_pair("successive-shortest-path", &algorithms::MinimumCostFlowAlgorithms::SuccessiveShortestPath),
+        std::make_pair("primal-dual", &algorithms::MinimumCostFlowAlgorithms::PrimalDual) }) {
+
+        try {
+            utils::ThreadPool::SetNumThreads(1);
+            auto sequential = algorithm(graph, source, sink)->getFlow();
+            utils::ThreadPool::SetNumThreads(4);
+            auto parallel = algorithm(graph, source, sink)->getFlow();
+            passed &= tests::TestUtils::Check(sequential == parallel, std::string(name) + ": " + std::to_string(sequential)
+                + " with one thread, " + std::to_string(parallel) + " with four threads");
+        } catch (std::exception& e) {
+            passed &= tests::TestUtils::Check(false, std::string(name) + ": " + e.what());
+        }
+    }
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,53 @@
+#include "TestUtils.h"
+
+#include "algorithms/MaximumFlowAlgorithms.h"
+#include "algorithms/MinimumCostFlowAlgorithms.h"
+
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <utility>
+#include <stdexcept>
+
+/**
+ * Every algorithm rejects a source equal to the sink (or out of the graph) with invalid_argument,
+ * instead of augmenting forever along the path without arcs.
+ */
+int main() {
+    auto graph = tests::TestUtils::RandomGraph(31, 6, 12, 9, 1, 9);
+    bool passed { true };
+
+    using Algorithm = std::shared_ptr<dto::FlowResult> (*)(const std::shared_ptr<data_structures::Graph>&, int, int);
+    const std::vector<std::pair<std::string, Algorithm>> algorithms {
+        { "edmonds-karp", &algorithms::MaximumFlowAlgorithms::EdmondsKarp },
+        { "push-relabel", &algorithms::MaximumFlowAlgorithms::ParallelPushRelabel },
+        { "cycle-cancelling", &algorithms::MinimumCostFlowAlgorithms::CycleCancelling },
+        { "successive-shortest-path", &algorithms::MinimumCostFlowAlgorithms::SuccessiveShortestPath },
+        { "primal-dual", &algorithms::MinimumCostFlowAlgorithms::PrimalDual } };
+
+    for (const auto& [name, algorithm] : algorithms) {
+
+        for (const auto& [source, sink] : { std::make_pair(2, 2), std::make_pair(0, 6) }) {
+            bool rejected { false };
+            try {
+                algorithm(graph, source, sink);
+            } catch (std::invalid_argument&) {
+                rejected = true;
+            }
+            passed &= tests::TestUtils::Check(rejected, name + ": source " + std::to_string(source)
+                + " and sink " + std::to_string(sink) + " not rejected");
+        }
+    }
+
+    // a graph with a single node has no sink different from the source
+    auto single_node = std::make_shared<data_structures::Graph>(1);
+    bool rejected { false };
+    try {
+        algorithms::MaximumFlowAlgorithms::EdmondsKarp(single_node, 0, 0);
+    } catch (std::invalid_argument&) {
+        rejected = true;
+    }
+    passed &= tests::TestUtils::Check(rejected, "edmonds-karp: single node graph not rejected");
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
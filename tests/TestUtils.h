@@ -0,0 +1,69 @@
+#ifndef MINIMUM_COST_FLOWS_PROBLEM_TESTUTILS_H
+#define MINIMUM_COST_FLOWS_PROBLEM_TESTUTILS_H
+
+#include "types/Types.h"
+#include "data_structures/graph/Graph.h"
+
+#include <memory>
+#include <random>
+#include <string>
+#include <iostream>
+
+namespace tests {
+    /**
+     * Helpers shared by the tests: the checks and the random graphs.
+     */
+    class TestUtils {
+        public:
+            /**
+             * Check a condition, printing the message if it is false.
+             *
+             * @param condition the condition
+             * @param message   the description of the check
+             *
+             * @return the condition
+             */
+            static bool Check(bool condition, const std::string& message) {
+                if (!condition) {
+                    std::cerr << "FAILED: " << message << std::endl;
+                }
+                return condition;
+            }
+
+            /**
+             * Create a random graph without parallel edges and self-loops.
+             *
+             * @param seed         the seed of the generator
+             * @param num_nodes    the number of nodes
+             * @param num_edges    the number of edges (at most num_nodes * (num_nodes - 1))
+             * @param max_capacity the maximum capacity, the capacities are in [0, max_capacity]
+             * @param min_cost     the minimum cost
+             * @param max_cost     the maximum cost
+             *
+             * @return the graph
+             */
+            static std::shared_ptr<data_structures::Graph> RandomGraph(unsigned seed, int num_nodes, int num_edges,
+                types::capacity_t max_capacity, types::cost_t min_cost, types::cost_t max_cost) {
+
+                std::mt19937 generator { seed };
+                std::uniform_int_distribution<int> node_distribution(0, num_nodes - 1);
+                std::uniform_int_distribution<long long> capacity_distribution(0, max_capacity);
+                std::uniform_int_distribution<long long> cost_distribution(min_cost, max_cost);
+
+                auto graph = std::make_shared<data_structures::Graph>(num_nodes);
+                for (int edges = 0; edges < num_edges;) {
+                    int source { node_distribution(generator) };
+                    int sink { node_distribution(generator) };
+                    if (source == sink || graph->hasEdge(source, sink)) {
+                        continue;
+                    }
+                    graph->addEdge(source, sink, static_cast<types::capacity_t>(capacity_distribution(generator)),
+                        static_cast<types::cost_t>(cost_distribution(generator)));
+                    edges++;
+                }
+                return graph;
+            }
+    };
+}
+
+#endif //MINIMUM_COST_FLOWS_PROBLEM_TESTUTILS_H